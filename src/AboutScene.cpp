@@ -5,6 +5,8 @@
 #include "FileParser.h"
 #include "AboutScene.h"
 #include "BootLog.h"
+#include "LoopProfile.h"
+#include "JogLatency.h"
 
 extern Scene menuScene;
 
@@ -94,6 +96,34 @@ void AboutScene::reDisplay() {
     text(intToCStr(_brightness), val_x, y, GREEN, TINY, bottom_left);
 #endif
 
+    // Frames pushed / frames skipped because the scene redrew the same thing
+    std::string frames_str = intToCStr(display_frames_pushed());
+    frames_str += " / ";
+    frames_str += intToCStr(display_frames_skipped());
+    text("Frames:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
+    text(frames_str.c_str(), val_x, y, GREEN, TINY, bottom_left);
+
+#ifdef LOOP_PROFILE
+    // Slowest loop iterations and how many went over the stall threshold
+    char loop_str[32];
+    snprintf(loop_str, sizeof(loop_str), "%uus, %u stalls", loop_iteration_histogram().percentile(99), loop_stalls());
+    text("Loop p99:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
+    text(loop_str, val_x, y, loop_stalls() ? YELLOW : GREEN, TINY, bottom_left);
+#endif
+
+#ifdef JOG_LATENCY
+    // Median dial-to-ok and dial-to-DRO delay on the current transport, in ms
+    jog_transport_t transport = jog_latency_transport();
+    char            jog_str[32];
+    snprintf(jog_str,
+             sizeof(jog_str),
+             "%u / %u ms",
+             jog_latency_histogram(transport, JOG_TICK_TO_OK).percentile(50) / 1000,
+             jog_latency_histogram(transport, JOG_TICK_TO_DRO).percentile(50) / 1000);
+    text("Jog ok/DRO:", key_x, y += y_spacing, LIGHTGREY, TINY, bottom_right);
+    text(jog_str, val_x, y, GREEN, TINY, bottom_left);
+#endif
+
     if (wifi_ssid.length()) {
         std::string wifi_str = wifi_mode;
         if (wifi_mode == "No Wifi") {
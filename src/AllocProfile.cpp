@@ -0,0 +1,108 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "AllocProfile.h"
+
+#if defined(ALLOC_PROFILE) && !defined(ARDUINO)
+#    include "HeapStats.h"    // heap_allocations()
+#    include "LoopProfile.h"  // loop_phase_name()
+#    include "System.h"       // dbg_printf()
+
+struct AllocStats {
+    uint32_t events = 0;
+    uint32_t allocs = 0;
+    uint32_t max    = 0;
+
+    void add(uint32_t n) {
+        ++events;
+        allocs += n;
+        if (n > max) {
+            max = n;
+        }
+    }
+    void print(const char* label) const {
+        dbg_printf("%-22s %8u %10u %8u.%02u %6u\n",
+                   label,
+                   events,
+                   allocs,
+                   events ? allocs / events : 0,
+                   events ? allocs * 100 / events % 100 : 0,
+                   max);
+    }
+};
+
+struct SceneAllocs {
+    const char* name;
+    AllocStats  frames;
+};
+
+static AllocStats  phase_stats[N_LOOP_PHASES];
+static AllocStats  iteration_stats;
+static AllocStats  report_stats;
+static SceneAllocs scene_stats[ALLOC_PROFILE_SCENES];
+static int         n_scenes = 0;
+
+static uint32_t iteration_start = 0;
+static uint32_t last_mark       = 0;
+static uint32_t phase_allocs[N_LOOP_PHASES];
+static uint32_t frame_start  = 0;
+static uint32_t report_start = 0;
+
+void alloc_profile_begin() {
+    for (auto& n : phase_allocs) {
+        n = 0;
+    }
+    iteration_start = last_mark = heap_allocations();
+}
+
+void alloc_profile_mark(int phase) {
+    uint32_t now = heap_allocations();
+    phase_allocs[phase] += now - last_mark;
+    last_mark = now;
+}
+
+void alloc_profile_end() {
+    for (int i = 0; i < N_LOOP_PHASES; i++) {
+        phase_stats[i].add(phase_allocs[i]);
+    }
+    iteration_stats.add(heap_allocations() - iteration_start);
+}
+
+void alloc_profile_frame_begin() {
+    frame_start = heap_allocations();
+}
+
+void alloc_profile_frame_end(const char* scene) {
+    uint32_t n = heap_allocations() - frame_start;
+    for (int i = 0; i < n_scenes; i++) {
+        if (scene_stats[i].name == scene) {
+            scene_stats[i].frames.add(n);
+            return;
+        }
+    }
+    if (n_scenes < ALLOC_PROFILE_SCENES) {
+        scene_stats[n_scenes].name = scene;
+        scene_stats[n_scenes].frames.add(n);
+        ++n_scenes;
+    }
+}
+
+void alloc_profile_report_begin() {
+    report_start = heap_allocations();
+}
+
+void alloc_profile_report_end() {
+    report_stats.add(heap_allocations() - report_start);
+}
+
+void alloc_profile_dump() {
+    dbg_printf("%-22s %8s %10s %11s %6s\n", "allocations", "events", "allocs", "mean", "max");
+    iteration_stats.print("loop iteration");
+    for (int i = 0; i < N_LOOP_PHASES; i++) {
+        phase_stats[i].print(loop_phase_name(i));
+    }
+    report_stats.print("status report");
+    for (int i = 0; i < n_scenes; i++) {
+        scene_stats[i].frames.print(scene_stats[i].name);
+    }
+}
+#endif
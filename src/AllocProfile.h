@@ -0,0 +1,48 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Allocation profiler for host builds.
+//
+// Built with -DALLOC_PROFILE on a host build.  Every operator new on the
+// main thread (see HeapStats.h) is charged to the loop phase it happens
+// in, and allocations made while a scene redraws are charged to that
+// scene, so the report shows allocations per loop iteration, per frame of
+// each scene and per parsed status report (from the start of the report
+// through onDROChange()).  In steady state - the DRO updating, a jog
+// streaming - all of these should be zero; anything else is a std::string
+// or container being rebuilt on a hot path.
+//
+// The loop phases come from the loop_profile_mark() calls in loop(), which
+// drive this profiler whether or not LOOP_PROFILE is on.
+// alloc_profile_dump() prints the report; a --replay run prints it at the
+// end.  Firmware builds compile the hooks to nothing.
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef ALLOC_PROFILE_SCENES
+#    define ALLOC_PROFILE_SCENES 32
+#endif
+
+#if defined(ALLOC_PROFILE) && !defined(ARDUINO)
+void alloc_profile_begin();
+void alloc_profile_mark(int phase);  // Allocations since the previous mark belong to phase
+void alloc_profile_end();
+
+void alloc_profile_frame_begin();
+void alloc_profile_frame_end(const char* scene);
+
+void alloc_profile_report_begin();
+void alloc_profile_report_end();
+
+void alloc_profile_dump();
+#else
+inline void alloc_profile_begin() {}
+inline void alloc_profile_mark(int phase) {}
+inline void alloc_profile_end() {}
+inline void alloc_profile_frame_begin() {}
+inline void alloc_profile_frame_end(const char* scene) {}
+inline void alloc_profile_report_begin() {}
+inline void alloc_profile_report_end() {}
+inline void alloc_profile_dump() {}
+#endif
@@ -0,0 +1,176 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "AsyncPush.h"
+#include "System.h"
+#include "Drawing.h"
+
+#ifndef DISPLAY_ASYNC_PUSH
+bool async_push(int x, int y, int width, int height) {
+    return false;
+}
+void display_wait_idle() {}
+uint32_t display_push_waits() {
+    return 0;
+}
+#else
+#    include "Metrics.h"
+#    include <cstring>
+#    ifdef ARDUINO
+#        include <freertos/FreeRTOS.h>
+#        include <freertos/task.h>
+#        include <freertos/semphr.h>
+#    else
+#        include <thread>
+#        include <mutex>
+#        include <condition_variable>
+#    endif
+
+static LGFX_Sprite* front       = nullptr;  // The copy the worker is sending
+static bool         init_failed = false;
+static Counter      push_waits("display.push_waits");
+
+// The rectangle being sent, in canvas coordinates, and where the canvas
+// was on the panel when the frame was queued
+static int push_x;
+static int push_y;
+static int push_width;
+static int push_height;
+static int push_offset_x;
+static int push_offset_y;
+
+static void push_front() {
+    display.startWrite();
+    display.setClipRect(push_offset_x + push_x, push_offset_y + push_y, push_width, push_height);
+    front->pushSprite(push_offset_x, push_offset_y);
+    display.clearClipRect();
+    display.endWrite();
+}
+
+#    ifdef ARDUINO
+static TaskHandle_t      push_task = nullptr;
+static SemaphoreHandle_t push_done = nullptr;
+static volatile bool     busy      = false;
+
+static void pushTask(void* arg) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        push_front();
+        busy = false;
+        xSemaphoreGive(push_done);
+    }
+}
+
+static bool start_worker() {
+    push_done = xSemaphoreCreateBinary();
+    if (!push_done) {
+        return false;
+    }
+    return xTaskCreate(pushTask, "display_push", 4096, nullptr, 2, &push_task) == pdPASS;
+}
+
+static void start_push() {
+    xSemaphoreTake(push_done, 0);  // Discard the completion of a push nobody waited for
+    busy = true;
+    xTaskNotifyGive(push_task);
+}
+
+void display_wait_idle() {
+    if (!busy) {
+        return;
+    }
+    ++push_waits;
+    xSemaphoreTake(push_done, portMAX_DELAY);
+}
+#    else
+static std::mutex              push_mutex;
+static std::condition_variable push_cond;
+static bool                    requested = false;
+static bool                    busy      = false;
+
+static void push_thread() {
+    std::unique_lock<std::mutex> lock(push_mutex);
+    while (true) {
+        push_cond.wait(lock, [] { return requested; });
+        requested = false;
+        lock.unlock();
+        push_front();
+        lock.lock();
+        busy = false;
+        push_cond.notify_all();
+    }
+}
+
+static bool start_worker() {
+    std::thread(push_thread).detach();
+    return true;
+}
+
+static void start_push() {
+    std::lock_guard<std::mutex> lock(push_mutex);
+    busy      = true;
+    requested = true;
+    push_cond.notify_all();
+}
+
+void display_wait_idle() {
+    std::unique_lock<std::mutex> lock(push_mutex);
+    if (!busy) {
+        return;
+    }
+    ++push_waits;
+    push_cond.wait(lock, [] { return !busy; });
+}
+#    endif
+
+static bool init_async_push() {
+    if (init_failed) {
+        return false;
+    }
+    front = new LGFX_Sprite(&display);
+    front->setColorDepth(canvas.getColorDepth());
+    if (!front->createSprite(canvas.width(), canvas.height()) || !start_worker()) {
+        dbg_println("Async display push unavailable, pushing synchronously");
+        delete front;
+        front       = nullptr;
+        init_failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool async_push(int x, int y, int width, int height) {
+    if (!front && !init_async_push()) {
+        return false;
+    }
+    if (front->width() != canvas.width() || front->height() != canvas.height()) {
+        return false;
+    }
+
+    // The swap: the front copy may only change once the panel has it
+    display_wait_idle();
+
+    int      bytes_per_pixel = ((int)canvas.getColorDepth() & 0xff) / 8;
+    int      stride          = canvas.width() * bytes_per_pixel;
+    int      row_bytes       = width * bytes_per_pixel;
+    uint8_t* src             = (uint8_t*)canvas.getBuffer() + y * stride + x * bytes_per_pixel;
+    uint8_t* dst             = (uint8_t*)front->getBuffer() + y * stride + x * bytes_per_pixel;
+    for (int row = 0; row < height; row++) {
+        memcpy(dst, src, row_bytes);
+        src += stride;
+        dst += stride;
+    }
+
+    push_x        = x;
+    push_y        = y;
+    push_width    = width;
+    push_height   = height;
+    push_offset_x = sprite_offset.x;
+    push_offset_y = sprite_offset.y;
+    start_push();
+    return true;
+}
+
+uint32_t display_push_waits() {
+    return push_waits.value();
+}
+#endif
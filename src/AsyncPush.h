@@ -0,0 +1,33 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Background display pushes.
+//
+// Normally refreshDisplay() sends the damaged part of the canvas to the panel
+// from the main loop, which cannot drain received bytes or sample the
+// encoder until the transfer is over.  With -DDISPLAY_ASYNC_PUSH the canvas
+// is double-buffered: refreshDisplay() copies the damaged rectangle into a
+// second sprite of the same color depth and returns, and a worker converts
+// and sends that sprite to the panel while the next frame is rendered into
+// the canvas.  On ESP32 the worker is a FreeRTOS task; on host builds it is
+// a thread, so the same pipelining can be exercised under the simulator.
+// Either way the worker's pushSprite() is an ordinary blocking transfer,
+// not DMA; it is the main loop that no longer waits for it.
+//
+// The copy into the second sprite waits for the previous push to finish,
+// so at most one frame is ever in flight.  Code that draws on the display
+// directly, bypassing the canvas, must call display_wait_idle() first.
+
+#pragma once
+
+#include <cstdint>
+
+// Queue the canvas rectangle for a background push.  Returns false if the
+// async path is not built in or its buffer could not be allocated, in which
+// case the caller pushes synchronously.
+bool async_push(int x, int y, int width, int height);
+
+// Block until the push in flight, if any, has finished
+void display_wait_idle();
+
+// Number of times the main loop had to wait for a push to finish
+uint32_t display_push_waits();
@@ -0,0 +1,59 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Clock.h"
+
+#ifndef ARDUINO
+#    include <chrono>
+
+static bool     virtual_time = false;
+static uint64_t virtual_us   = 0;
+static int64_t  wall_offset  = 0;  // Added to the wall clock, so leaving virtual time does not jump
+
+static uint64_t wall_us() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() + wall_offset;
+}
+
+static uint64_t now_us() {
+    return virtual_time ? virtual_us : wall_us();
+}
+
+uint32_t clock_ms() {
+    return now_us() / 1000;
+}
+uint32_t clock_us() {
+    return now_us();
+}
+
+void clock_set_virtual(bool on) {
+    if (on && !virtual_time) {
+        virtual_us = wall_us();
+    }
+    if (!on && virtual_time) {
+        // Carry on from the virtual reading
+        wall_offset += (int64_t)(virtual_us - wall_us());
+    }
+    virtual_time = on;
+}
+bool clock_is_virtual() {
+    return virtual_time;
+}
+
+void clock_advance_ms(uint32_t ms) {
+    virtual_us += (uint64_t)ms * 1000;
+}
+void clock_advance_us(uint32_t us) {
+    virtual_us += us;
+}
+
+extern void loop();
+
+void clock_fast_forward(uint32_t ms, uint32_t step_ms) {
+    clock_set_virtual(true);
+    uint64_t end = virtual_us + (uint64_t)ms * 1000;
+    while (virtual_us < end) {
+        clock_advance_ms(step_ms);
+        loop();
+    }
+}
+#endif
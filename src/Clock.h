@@ -0,0 +1,37 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Controllable clock for host builds.
+//
+// On host builds every timekeeping call - milliseconds(), millis(),
+// microseconds() and delay_ms() - reads this clock, so the timeouts that
+// drive the pendant (jog in-flight staleness, the ping and disconnect ladder,
+// jog cancel resends, file chain cooldowns, config request retries) can run
+// on simulated time.  It follows the wall clock until clock_set_virtual()
+// freezes it; from then on it only moves when clock_advance_ms() is called,
+// or when delay_ms() advances it instead of sleeping.  clock_fast_forward()
+// runs the main loop across a stretch of virtual time, so hours of session
+// time take seconds and every latency measured against it is deterministic.
+//
+// Arduino builds use the hardware timers directly and do not have this.
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef ARDUINO
+uint32_t clock_ms();
+uint32_t clock_us();
+
+// Switch between virtual and wall clock time.  Either way the clock carries
+// on from its current reading, so it never jumps backward.
+void clock_set_virtual(bool on);
+bool clock_is_virtual();
+
+void clock_advance_ms(uint32_t ms);
+void clock_advance_us(uint32_t us);
+
+// Run loop() repeatedly, advancing virtual time by step_ms before each call,
+// until ms of virtual time have passed.  Switches to virtual time if the
+// clock is not already on it.
+void clock_fast_forward(uint32_t ms, uint32_t step_ms = 1);
+#endif
@@ -1,11 +1,13 @@
 #include "ConfigItem.h"
 #include "Scene.h"
 #include "System.h"
+#include "Metrics.h"
 
 std::vector<ConfigItem*> configRequests;
 
 static constexpr uint32_t CONFIG_REQUEST_RETRY_MS = 500;
 static uint32_t           configRequestSentMs     = 0;
+static Counter            configRetries("config.retries");
 
 static void send_next_config_request() {
     if (configRequests.empty()) {
@@ -40,6 +42,7 @@ void clear_config_requests() {
 void service_config_requests() {
     if (!configRequests.empty() &&
         (uint32_t)(millis() - configRequestSentMs) >= CONFIG_REQUEST_RETRY_MS) {
+        ++configRetries;
         send_next_config_request();
     }
 }
@@ -0,0 +1,76 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Diagnostics: the metrics registry on the display, refreshed while it is
+// shown.  Turn the dial to scroll; the green button dumps the list over the
+// debug port as well.
+
+#include "Scene.h"
+#include "Metrics.h"
+
+class DiagnosticsScene : public Scene {
+private:
+    static const int ROWS       = 9;
+    static const int ROW_HEIGHT = 17;
+    static const int REFRESH_MS = 500;
+
+    int      _top     = 0;
+    uint32_t _last_ms = 0;
+
+public:
+    DiagnosticsScene() : Scene("Diagnostics") {}
+
+    void onEntry(void* arg) override {
+        _top = 0;
+        reDisplay();
+    }
+
+    void onEncoder(int delta) override {
+        int max_top = metrics_count() - ROWS;
+        _top += delta;
+        if (_top > max_top) {
+            _top = max_top;
+        }
+        if (_top < 0) {
+            _top = 0;
+        }
+        reDisplay();
+    }
+
+    void onPoll() override {
+        if (millis() - _last_ms >= REFRESH_MS) {
+            request_redisplay();
+        }
+    }
+
+    void onDialButtonPress() override { pop_scene(); }
+    void onRedButtonPress() override { pop_scene(); }
+    void onGreenButtonPress() override { metrics_dump(); }
+    void onTouchClick() override {
+        if (touchIsCenter()) {
+            pop_scene();
+        }
+    }
+
+    void reDisplay() override {
+        _last_ms = millis();
+        background();
+        drawMenuTitle(name());
+
+        int y = 48;
+        for (int i = _top; i < _top + ROWS; i++) {
+            Metric* m = metric_at(i);
+            if (!m) {
+                break;
+            }
+            char value[32];
+            char row[80];
+            m->format(value, sizeof(value));
+            snprintf(row, sizeof(row), "%s %s", m->name(), value);
+            centered_text(row, y, m->kind() == Metric::HISTOGRAM ? CYAN : LIGHTGREY, TINY);
+            y += ROW_HEIGHT;
+        }
+
+        drawButtonLegends("Back", "Dump", "");
+        refreshDisplay();
+    }
+} diagnosticsScene;
@@ -4,18 +4,190 @@
 #include "System.h"
 #include "Drawing.h"
 #include "alarm.h"
+#include "AsyncPush.h"
+#include "Metrics.h"
+#include "SpanTrace.h"
+#include "StaticLayer.h"  // static_layer_end_frame()
 #include <map>
+#include <algorithm>
+#include <cstring>
 #ifdef USE_WIFI
 #    include "WiFiConnection.h"
 #    include "PeerLink.h"
 #endif
 
+// Bounding box of everything drawn since the last refreshDisplay().
+// The box is empty when dirty_x0 >= dirty_x1; the far edges are exclusive.
+static int dirty_x0 = 0;
+static int dirty_y0 = 0;
+static int dirty_x1 = 0;
+static int dirty_y1 = 0;
+
+// Bounding box of everything drawn since the last take_canvas_damage()
+static int damage_x0 = 0;
+static int damage_y0 = 0;
+static int damage_x1 = 0;
+static int damage_y1 = 0;
+
+// The areas in that box, apart from DRO cells, for static_layer_end_frame().
+// Once there are more than fit, the last one grows to cover the rest.
+static const int  max_damage_rects = 16;
+static CanvasRect damage_rects[max_damage_rects];
+static int        n_damage_rects = 0;
+
+static uint32_t bytes_pushed = 0;
+static Counter  bytes_pushed_total("display.bytes_pushed");
+
+// FNV-1a hash of the draw operations since the last refreshDisplay()
+static const uint32_t fnv_offset_basis = 2166136261u;
+static const uint32_t fnv_prime        = 16777619u;
+
+static uint32_t frame_hash      = fnv_offset_basis;
+static uint32_t last_frame_hash = 0;
+static bool     have_last_frame = false;
+static Counter  frames_pushed("display.frames_pushed");
+static Counter  frames_skipped("display.frames_skipped");
+
+static uint32_t draw_generation = 0;
+
+// Content generation of each background sprite, from sprite_changed()
+static std::map<LGFX_Sprite*, uint32_t> sprite_generations;
+
+static void dro_note_damage(int x, int y, int x1, int y1);
+static void note_damage_rect(int x, int y, int x1, int y1);
+
+// Clip a rectangle to the canvas, returning false if nothing is left
+static bool clip_to_canvas(int& x, int& y, int& x1, int& y1) {
+    if (x < 0) {
+        x = 0;
+    }
+    if (y < 0) {
+        y = 0;
+    }
+    if (x1 > canvas.width()) {
+        x1 = canvas.width();
+    }
+    if (y1 > canvas.height()) {
+        y1 = canvas.height();
+    }
+    return x < x1 && y < y1;
+}
+
+static void grow_box(int& bx0, int& by0, int& bx1, int& by1, int x, int y, int x1, int y1) {
+    if (bx0 >= bx1) {
+        bx0 = x;
+        by0 = y;
+        bx1 = x1;
+        by1 = y1;
+        return;
+    }
+    bx0 = std::min(bx0, x);
+    by0 = std::min(by0, y);
+    bx1 = std::max(bx1, x1);
+    by1 = std::max(by1, y1);
+}
+
+void mark_dirty(int x, int y, int width, int height) {
+    int x1 = x + width;
+    int y1 = y + height;
+    if (!clip_to_canvas(x, y, x1, y1)) {
+        return;
+    }
+    dro_note_damage(x, y, x1, y1);
+    note_damage_rect(x, y, x1, y1);
+    grow_box(dirty_x0, dirty_y0, dirty_x1, dirty_y1, x, y, x1, y1);
+    grow_box(damage_x0, damage_y0, damage_x1, damage_y1, x, y, x1, y1);
+}
+
+void mark_restored(int x, int y, int width, int height) {
+    int x1 = x + width;
+    int y1 = y + height;
+    if (clip_to_canvas(x, y, x1, y1)) {
+        grow_box(dirty_x0, dirty_y0, dirty_x1, dirty_y1, x, y, x1, y1);
+    }
+}
+
+bool take_canvas_damage(CanvasRect& rect) {
+    if (damage_x0 >= damage_x1) {
+        return false;
+    }
+    rect      = { damage_x0, damage_y0, damage_x1 - damage_x0, damage_y1 - damage_y0 };
+    damage_x0 = damage_x1 = 0;
+    damage_y0 = damage_y1 = 0;
+    n_damage_rects        = 0;
+    return true;
+}
+int canvas_damage_rects(const CanvasRect** rects) {
+    *rects = damage_rects;
+    return n_damage_rects;
+}
+void mark_all_dirty() {
+    mark_dirty(0, 0, canvas.width(), canvas.height());
+}
+
+uint32_t display_bytes_pushed() {
+    return bytes_pushed;
+}
+uint32_t display_bytes_pushed_total() {
+    return bytes_pushed_total.value();
+}
+
+static void hash_byte(uint8_t b) {
+    frame_hash = (frame_hash ^ b) * fnv_prime;
+}
+static void hash_int(int value) {
+    uint32_t v = value;
+    for (int i = 0; i < 4; i++) {
+        hash_byte(v & 0xff);
+        v >>= 8;
+    }
+}
+void hash_draw(draw_op_t op, int a, int b, int c, int d, int e, int f) {
+    hash_int(op);
+    hash_int(a);
+    hash_int(b);
+    hash_int(c);
+    hash_int(d);
+    hash_int(e);
+    hash_int(f);
+}
+uint32_t next_draw_generation() {
+    return ++draw_generation;
+}
+
+void sprite_changed(LGFX_Sprite* sprite) {
+    sprite_generations[sprite] = next_draw_generation();
+}
+
+void hash_draw(const char* str) {
+    while (*str) {
+        hash_byte(*str++);
+    }
+    hash_byte(0);  // So that "ab","c" differs from "a","bc"
+}
+
+void invalidate_display() {
+    have_last_frame = false;
+    mark_all_dirty();
+}
+
+uint32_t display_frames_pushed() {
+    return frames_pushed.value();
+}
+uint32_t display_frames_skipped() {
+    return frames_skipped.value();
+}
+
 void drawBackground(int color) {
     canvas.fillSprite(color);
+    mark_all_dirty();
+    hash_draw(OP_BACKGROUND, color);
 }
 
 void drawFilledCircle(int x, int y, int radius, int fillcolor) {
     canvas.fillCircle(x, y, radius, fillcolor);
+    mark_dirty(x - radius, y - radius, 2 * radius + 1, 2 * radius + 1);
+    hash_draw(OP_FILLED_CIRCLE, x, y, radius, fillcolor);
 }
 void drawFilledCircle(Point xy, int radius, int fillcolor) {
     Point dispxy = xy.to_display();
@@ -26,6 +198,8 @@ void drawCircle(int x, int y, int radius, int thickness, int outlinecolor) {
     for (int i = 0; i < thickness; i++) {
         canvas.drawCircle(x, y, radius - i, outlinecolor);
     }
+    mark_dirty(x - radius, y - radius, 2 * radius + 1, 2 * radius + 1);
+    hash_draw(OP_CIRCLE, x, y, radius, thickness, outlinecolor);
 }
 void drawCircle(Point xy, int radius, int thickness, int outlinecolor) {
     Point dispxy = xy.to_display();
@@ -35,6 +209,8 @@ void drawCircle(Point xy, int radius, int thickness, int outlinecolor) {
 void drawOutlinedCircle(int x, int y, int radius, int fillcolor, int outlinecolor) {
     canvas.fillCircle(x, y, radius, fillcolor);
     canvas.drawCircle(x, y, radius, outlinecolor);
+    mark_dirty(x - radius, y - radius, 2 * radius + 1, 2 * radius + 1);
+    hash_draw(OP_OUTLINED_CIRCLE, x, y, radius, fillcolor, outlinecolor);
 }
 void drawOutlinedCircle(Point xy, int radius, int fillcolor, int outlinecolor) {
     Point dispxy = xy.to_display();
@@ -43,6 +219,8 @@ void drawOutlinedCircle(Point xy, int radius, int fillcolor, int outlinecolor) {
 
 void drawRect(int x, int y, int width, int height, int radius, int bgcolor) {
     canvas.fillRoundRect(x, y, width, height, radius, bgcolor);
+    mark_dirty(x, y, width, height);
+    hash_draw(OP_RECT, x, y, width, height, radius, bgcolor);
 }
 void drawRect(Point xy, int width, int height, int radius, int bgcolor) {
     Point offsetxy = { width / 2, -height / 2 };    // { 30, -30}
@@ -56,6 +234,8 @@ void drawRect(Point xy, Point wh, int radius, int bgcolor) {
 void drawOutlinedRect(int x, int y, int width, int height, int bgcolor, int outlinecolor) {
     canvas.fillRoundRect(x, y, width, height, 5, bgcolor);
     canvas.drawRoundRect(x, y, width, height, 5, outlinecolor);
+    mark_dirty(x, y, width, height);
+    hash_draw(OP_OUTLINED_RECT, x, y, width, height, bgcolor, outlinecolor);
 }
 void drawOutlinedRect(Point xy, int width, int height, int bgcolor, int outlinecolor) {
     Point dispxy = xy.to_display();
@@ -65,18 +245,36 @@ void drawPngFile(const char* filename, Point xy) {
     //    drawPngFile(filename, xo(xy.x), yo(xy.y));
     //    drawPngFile(filename, xy.x - 40, xy.y);
     drawPngFile(filename, xy.x, xy.y);
+    mark_all_dirty();  // The image extent is not known here
+    hash_draw(OP_PNG, xy.x, xy.y);
+    hash_draw(filename);
 }
 void drawPngBackground(const char* filename) {
     drawPngFile(filename, 0, 0);
+    mark_all_dirty();
+    hash_draw(OP_PNG);
+    hash_draw(filename);
+}
+void drawBackground(int x, int y, int width, int height) {
+    system_background(x, y, width, height);
+    mark_dirty(x, y, width, height);
+    hash_draw(OP_BACKGROUND_RECT, x, y, width, height);
 }
 void drawBackground(LGFX_Sprite* sprite) {
     sprite->pushSprite(0, 0);
+    mark_all_dirty();
+    // A sprite nobody has reported on could hold anything, so it never
+    // hashes the same twice
+    auto     it         = sprite_generations.find(sprite);
+    uint32_t generation = it == sprite_generations.end() ? next_draw_generation() : it->second;
+    hash_draw(OP_SPRITE, (int)generation);
 }
 LGFX_Sprite* createPngBackground(const char* filename) {
     LGFX_Sprite* sprite = new LGFX_Sprite(&canvas);
     sprite->setColorDepth(canvas.getColorDepth());
     sprite->createSprite(canvas.width(), canvas.height());
     drawPngFile(sprite, filename, 0, 0);
+    sprite_changed(sprite);
     return sprite;
 }
 
@@ -152,7 +350,7 @@ void drawStatus() {
             static const char* wifi_frames[] = { "Scanning", "Scanning.", "Scanning..", "Scanning..." };
             line2   = wifi_frames[(millis() / 400) % 4];
         }
-        canvas.fillRoundRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
+        drawRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
         centered_text(line1, y + height / 2 - 4, BLACK, SMALL);
         centered_text(line2, y + height / 2 + 12, BLACK, TINY);
         return;
@@ -161,7 +359,7 @@ void drawStatus() {
 
     int bgColor = stateBGColors[state];
     if (bgColor != 1) {
-        canvas.fillRoundRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
+        drawRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
     }
     int fgColor = stateFGColors[state];
     if (state == Alarm) {
@@ -178,7 +376,7 @@ void drawStatusTiny(int y) {
 
     int bgColor = stateBGColors[state];
     if (bgColor != 1) {
-        canvas.fillRoundRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
+        drawRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
     }
     centered_text(my_state_string, y + height / 2 + 3, stateFGColors[state], TINY);
 }
@@ -212,7 +410,7 @@ void drawStatusSmall(int y) {
             static const char* wifi_frames[] = { "WiFi", "WiFi.", "WiFi..", "WiFi..." };
             label   = wifi_frames[(millis() / 400) % 4];
         }
-        canvas.fillRoundRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
+        drawRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
         centered_text(label, y + height / 2 + 3, BLACK, TINY);
         return;
     }
@@ -220,7 +418,7 @@ void drawStatusSmall(int y) {
 
     int bgColor = stateBGColors[state];
     if (bgColor != 1) {
-        canvas.fillRoundRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
+        drawRect((display_short_side() - width) / 2, y, width, height, 5, bgColor);
     }
     centered_text(my_state_string, y + height / 2 + 3, stateFGColors[state], SMALL);
 }
@@ -261,17 +459,164 @@ void drawButtonLegends(const char* red, const char* green, const char* orange) {
     centered_text(orange, DIAL_BUTTON_LINE, ORANGE);
 }
 
-void putDigit(int& n, int x, int y, int color) {
-    char txt[2] = { '\0', '\0' };
-    txt[0]      = "0123456789"[n % 10];
-    n /= 10;
-    text(txt, x, y, color, MEDIUM, middle_right);
+// Incremental DRO renderer.
+//
+// The DRO is redrawn on every status report, and drawing each digit through
+// the GFXfont path (setFont/setTextDatum/setTextColor/drawString) is the
+// hottest part of jogging and cycle monitoring.  Instead, the digit glyphs
+// are rendered once into a 1-bit strip, one char_width cell per glyph, and
+// each DRO line remembers the glyph and color in every cell.  Only the cells
+// that changed are cleared and blitted from the strip.
+//
+// A line's memory is forgotten when anything else draws over it, as reported
+// through mark_dirty(); the next draw then repaints every cell on top of
+// whatever is there, exactly as the GFXfont path would.
+
+static const char dro_glyphs[]   = "0123456789.-";
+static const int  dro_char_width = 20;
+static const int  dro_max_cells  = 12;
+static const int  dro_n_lines    = 8;
+
+struct DroLine {
+    bool     valid;
+    int      x;      // Right edge of the number
+    int      y;      // Text middle
+    int      left;   // Left edge of the axis label
+    char     label;
+    int      label_color;
+    char     glyph[dro_max_cells];  // Rightmost cell first, ' ' when empty
+    int      color[dro_max_cells];
+    uint16_t bg[dro_max_cells];     // Background under each cell
+    uint16_t label_bg;
+    bool     drawn;  // Drawn since the last dro_keep_lines()
+};
+
+static DroLine      dro_lines[dro_n_lines];
+static int          dro_next_line = 0;
+static LGFX_Sprite* dro_strip     = nullptr;
+static int          dro_cell_h    = 0;
+static bool         dro_drawing   = false;  // Suppresses self-invalidation
+
+static bool init_dro_strip() {
+    if (dro_strip) {
+        return true;
+    }
+    canvas.setFont(font[MEDIUM]);
+    dro_cell_h = canvas.fontHeight();
+
+    int n_glyphs = strlen(dro_glyphs);
+    dro_strip    = new LGFX_Sprite(&canvas);
+    dro_strip->setColorDepth(1);
+    if (!dro_strip->createSprite(n_glyphs * dro_char_width, dro_cell_h)) {
+        delete dro_strip;
+        dro_strip = nullptr;
+        return false;
+    }
+    dro_strip->createPalette();
+    dro_strip->fillSprite(0);
+    dro_strip->setFont(font[MEDIUM]);
+    dro_strip->setTextColor(1);
+    // Place each glyph in its cell the same way fancyNumber() used to place
+    // it relative to the cell's right edge.
+    for (int i = 0; i < n_glyphs; i++) {
+        char txt[2] = { dro_glyphs[i], '\0' };
+        if (txt[0] == '.') {
+            dro_strip->setTextDatum(middle_center);
+            dro_strip->drawString(txt, i * dro_char_width + dro_char_width / 2, dro_cell_h / 2);
+        } else {
+            dro_strip->setTextDatum(middle_right);
+            dro_strip->drawString(txt, (i + 1) * dro_char_width, dro_cell_h / 2);
+        }
+    }
+    return true;
 }
-void fancyNumber(pos_t n, int n_decimals, int hl_digit, int x, int y, int text_color, int hl_text_color) {
-    fontnum_t font     = SMALL;
-    int       n_digits = n_decimals + 1;
-    int       i;
-    bool      isneg = n < 0;
+
+static void dro_note_damage(int x, int y, int x1, int y1) {
+    if (dro_drawing) {
+        return;
+    }
+    for (auto& line : dro_lines) {
+        if (!line.valid) {
+            continue;
+        }
+        int top = line.y - dro_cell_h / 2;
+        if (x < line.x && x1 > line.left && y < top + dro_cell_h && y1 > top) {
+            line.valid = false;
+        }
+    }
+}
+
+static void note_damage_rect(int x, int y, int x1, int y1) {
+    if (dro_drawing) {
+        return;
+    }
+    if (n_damage_rects < max_damage_rects) {
+        damage_rects[n_damage_rects++] = { x, y, x1 - x, y1 - y };
+        return;
+    }
+    CanvasRect& last = damage_rects[max_damage_rects - 1];
+    int         lx1  = last.x + last.width;
+    int         ly1  = last.y + last.height;
+    grow_box(last.x, last.y, lx1, ly1, x, y, x1, y1);
+    last.width  = lx1 - last.x;
+    last.height = ly1 - last.y;
+}
+
+static CanvasRect dro_line_rect(const DroLine& line) {
+    return { line.left, line.y - dro_cell_h / 2, line.x - line.left, dro_cell_h };
+}
+
+int dro_keep_lines(CanvasRect* rects, int max) {
+    int n = 0;
+    for (auto& line : dro_lines) {
+        line.drawn = false;
+        if (line.valid && n < max) {
+            rects[n++] = dro_line_rect(line);
+        }
+    }
+    return n;
+}
+
+bool dro_line_redrawn(const CanvasRect& rect) {
+    for (auto& line : dro_lines) {
+        if (line.valid && line.drawn) {
+            CanvasRect r = dro_line_rect(line);
+            if (r.x == rect.x && r.y == rect.y && r.width == rect.width && r.height == rect.height) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static DroLine& find_dro_line(int x, int y) {
+    for (auto& line : dro_lines) {
+        if (line.x == x && line.y == y) {
+            return line;
+        }
+    }
+    DroLine& line = dro_lines[dro_next_line];
+    dro_next_line = (dro_next_line + 1) % dro_n_lines;
+    line.valid    = false;
+    line.x        = x;
+    line.y        = y;
+    return line;
+}
+
+static void blit_dro_cell(char glyph, int right, int top, int color) {
+    int index = strchr(dro_glyphs, glyph) - dro_glyphs;
+    int left  = right - dro_char_width;
+    dro_strip->setPaletteColor(1, color);
+    canvas.setClipRect(left, top, dro_char_width, dro_cell_h);
+    dro_strip->pushSprite(left - index * dro_char_width, top, 0);
+    canvas.clearClipRect();
+}
+
+// Fill cells[] with the characters of n, rightmost first, and colors[] with
+// the color of each.  Returns the number of cells used.
+static int format_dro_number(pos_t n, int n_decimals, int hl_digit, int text_color, int hl_text_color, char* cells, int* colors) {
+    int  i;
+    bool isneg = n < 0;
     if (isneg) {
         n = -n;
     }
@@ -293,41 +638,136 @@ void fancyNumber(pos_t n, int n_decimals, int hl_digit, int x, int y, int text_c
         n *= 10;
     }
 #endif
-    const int char_width = 20;
-
-    int ni = (int)n;
-    for (i = 0; i < n_decimals; i++) {
-        putDigit(ni, x, y, i == hl_digit ? hl_text_color : text_color);
-        x -= char_width;
+    int ni    = (int)n;
+    int ncell = 0;
+    for (i = 0; i < n_decimals && ncell < dro_max_cells; i++) {
+        colors[ncell]  = i == hl_digit ? hl_text_color : text_color;
+        cells[ncell++] = '0' + ni % 10;
+        ni /= 10;
     }
-    if (n_decimals) {
-        text(".", x - 10, y, text_color, MEDIUM, middle_center);
-        x -= char_width;
+    if (n_decimals && ncell < dro_max_cells) {
+        colors[ncell]  = text_color;
+        cells[ncell++] = '.';
     }
     do {
-        putDigit(ni, x, y, i++ == hl_digit ? hl_text_color : text_color);
-        x -= char_width;
-    } while (ni || i <= hl_digit);
-    if (isneg) {
-        text("-", x, y, text_color, MEDIUM, middle_right);
+        colors[ncell]  = i++ == hl_digit ? hl_text_color : text_color;
+        cells[ncell++] = '0' + ni % 10;
+        ni /= 10;
+    } while ((ni || i <= hl_digit) && ncell < dro_max_cells);
+    if (isneg && ncell < dro_max_cells) {
+        colors[ncell]  = text_color;
+        cells[ncell++] = '-';
     }
+    return ncell;
+}
+
+// Draw the axis label at (label_x, y) and the number with its right edge at x
+static void drawDRONumber(
+    char label, int label_x, int label_color, pos_t n, int n_decimals, int hl_digit, int x, int y, int text_color, int hl_text_color) {
+    char txt[2] = { label, '\0' };
+    if (!init_dro_strip()) {
+        // No memory for the strip; fall back to the font path
+        text(txt, label_x, y, label_color, MEDIUM, middle_left);
+        char cells[dro_max_cells];
+        int  colors[dro_max_cells];
+        int  ncell = format_dro_number(n, n_decimals, hl_digit, text_color, hl_text_color, cells, colors);
+        for (int i = 0; i < ncell; i++) {
+            char c[2] = { cells[i], '\0' };
+            int  cx   = x - i * dro_char_width;
+            if (c[0] == '.') {
+                text(c, cx - dro_char_width / 2, y, colors[i], MEDIUM, middle_center);
+            } else {
+                text(c, cx, y, colors[i], MEDIUM, middle_right);
+            }
+        }
+        return;
+    }
+
+    DroLine& line = find_dro_line(x, y);
+    int      top  = y - dro_cell_h / 2;
+    line.drawn    = true;
+
+    char cells[dro_max_cells];
+    int  colors[dro_max_cells];
+    int  ncell = format_dro_number(n, n_decimals, hl_digit, text_color, hl_text_color, cells, colors);
+    for (int i = ncell; i < dro_max_cells; i++) {
+        cells[i]  = ' ';
+        colors[i] = 0;
+    }
+
+    dro_drawing = true;
+    if (!line.valid) {
+        // Whatever is on the canvas now is the background for this line
+        line.left     = label_x;
+        line.label_bg = canvas.readPixel(label_x, top);
+        for (int i = 0; i < dro_max_cells; i++) {
+            int left   = x - (i + 1) * dro_char_width;
+            line.bg[i] = canvas.readPixel(left < 0 ? 0 : left, top);
+        }
+    }
+    if (!line.valid || label != line.label || label_color != line.label_color) {
+        if (line.valid) {
+            canvas.setFont(font[MEDIUM]);
+            int width = canvas.textWidth(txt) + 2;
+            canvas.fillRect(label_x, top, width, dro_cell_h, line.label_bg);
+            mark_dirty(label_x, top, width, dro_cell_h);
+            hash_draw(OP_DRO_CLEAR, label_x, top, width, line.label_bg);
+        }
+        text(txt, label_x, y, label_color, MEDIUM, middle_left);
+        line.label       = label;
+        line.label_color = label_color;
+    }
+    for (int i = 0; i < dro_max_cells; i++) {
+        if (line.valid && cells[i] == line.glyph[i] && colors[i] == line.color[i]) {
+            continue;
+        }
+        int right = x - i * dro_char_width;
+        if (line.valid) {
+            canvas.fillRect(right - dro_char_width, top, dro_char_width, dro_cell_h, line.bg[i]);
+            hash_draw(OP_DRO_CLEAR, right - dro_char_width, top, dro_char_width, line.bg[i]);
+        }
+        if (cells[i] != ' ') {
+            blit_dro_cell(cells[i], right, top, colors[i]);
+            hash_draw(OP_DRO_CELL, cells[i], right, top, colors[i]);
+        }
+        mark_dirty(right - dro_char_width, top, dro_char_width, dro_cell_h);
+        line.glyph[i] = cells[i];
+        line.color[i] = colors[i];
+    }
+    line.valid  = true;
+    dro_drawing = false;
 }
 
 void DRO::drawHoming(int axis, bool highlight, bool homed) {
-    text(axisNumToCStr(axis), text_left_x(), text_middle_y(), myLimitSwitches[axis] ? GREEN : YELLOW, MEDIUM, middle_left);
-    fancyNumber(myAxes[axis], num_digits(), -1, text_right_x(), text_middle_y(), highlight ? (homed ? GREEN : RED) : DARKGREY, RED);
+    drawDRONumber(axisNumToChar(axis),
+                  text_left_x(),
+                  myLimitSwitches[axis] ? GREEN : YELLOW,
+                  dro_axis(axis),
+                  num_digits(),
+                  -1,
+                  text_right_x(),
+                  text_middle_y(),
+                  highlight ? (homed ? GREEN : RED) : DARKGREY,
+                  RED);
     advance();
 }
 
 void DRO::draw(int axis, int hl_digit, bool highlight) {
-    text(axisNumToCStr(axis), text_left_x(), text_middle_y(), highlight ? GREEN : DARKGREY, MEDIUM, middle_left);
-    fancyNumber(
-        myAxes[axis], num_digits(), hl_digit, text_right_x(), text_middle_y(), highlight ? WHITE : DARKGREY, highlight ? RED : DARKGREY);
+    drawDRONumber(axisNumToChar(axis),
+                  text_left_x(),
+                  highlight ? GREEN : DARKGREY,
+                  dro_axis(axis),
+                  num_digits(),
+                  hl_digit,
+                  text_right_x(),
+                  text_middle_y(),
+                  highlight ? WHITE : DARKGREY,
+                  highlight ? RED : DARKGREY);
     advance();
 }
 
 void DRO::draw(int axis, bool highlight) {
-    Stripe::draw(axisNumToChar(axis), pos_to_cstr(myAxes[axis], num_digits()), highlight, myLimitSwitches[axis] ? GREEN : WHITE);
+    Stripe::draw(axisNumToChar(axis), pos_to_cstr(dro_axis(axis), num_digits()), highlight, myLimitSwitches[axis] ? GREEN : WHITE);
 }
 
 void LED::draw(bool highlighted) {
@@ -362,6 +802,8 @@ void drawWiFiSignalBars(int x0, int y_bot) {
         int color = (i < bars) ? bar_color : DARKGREY;
         canvas.fillRect(x0 + i * (W + GAP), y_bot - H[i], W, H[i], color);
     }
+    mark_dirty(x0, y_bot - H[3], 4 * (W + GAP), H[3]);
+    hash_draw(OP_WIFI_BARS, x0, y_bot, bars, bar_color);
 }
 #endif
 
@@ -393,6 +835,9 @@ void drawBatteryLevel(int x0, int y_bot) {
     }
     if (charging) fill_color = BLACK;
 
+    mark_dirty(x0, y_bot - H, W + NW, H);
+    hash_draw(OP_BATTERY, x0, y_bot, fill_w, fill_color, charging);
+
     // Body outline and nub
     canvas.drawRect(x0, y_bot - H, W, H, WHITE);
     canvas.fillRect(x0 + W, y_bot - (H + NH) / 2, NW, NH, WHITE);
@@ -429,21 +874,58 @@ static void drawWiFiSignalOverlay() {
 #endif
 
 void refreshDisplay() {
+    TRACE_SPAN("refreshDisplay");
+    static_layer_end_frame();
 #ifdef USE_WIFI
     drawWiFiSignalOverlay();
 #endif
 #if defined(USE_M5) || defined(USE_LOVYANGFX)
     drawBatteryLevelOverlay();
 #endif
-    display.startWrite();
-    canvas.pushSprite(sprite_offset.x, sprite_offset.y);
-    display.endWrite();
+    if (dirty_x0 >= dirty_x1) {
+        bytes_pushed = 0;  // Nothing changed since the last push
+        frame_hash   = fnv_offset_basis;
+        return;
+    }
+
+    uint32_t hash   = frame_hash;
+    bool     repeat = have_last_frame && hash == last_frame_hash;
+    last_frame_hash = hash;
+    have_last_frame = true;
+    frame_hash      = fnv_offset_basis;
+    if (repeat) {
+        // The scene redrew what the panel already shows
+        ++frames_skipped;
+        bytes_pushed = 0;
+        dirty_x0 = dirty_x1 = 0;
+        dirty_y0 = dirty_y1 = 0;
+        return;
+    }
+
+    int width  = dirty_x1 - dirty_x0;
+    int height = dirty_y1 - dirty_y0;
+
+    // pushSprite() honors the destination clip rectangle, so only the
+    // damaged part of the canvas goes over the bus.
+    if (!async_push(dirty_x0, dirty_y0, width, height)) {
+        display.startWrite();
+        display.setClipRect(sprite_offset.x + dirty_x0, sprite_offset.y + dirty_y0, width, height);
+        canvas.pushSprite(sprite_offset.x, sprite_offset.y);
+        display.clearClipRect();
+        display.endWrite();
+    }
+
+    bytes_pushed = width * height * (((int)display.getColorDepth() & 0xff) / 8);
+    bytes_pushed_total += bytes_pushed;
+    ++frames_pushed;
+    dirty_x0 = dirty_x1 = 0;
+    dirty_y0 = dirty_y1 = 0;
 }
 
 void drawError() {
     if (lastError) {
         if ((milliseconds() - errorExpire) < 0) {
-            canvas.fillCircle(120, 120, 95, RED);
+            drawFilledCircle(120, 120, 95, RED);
             drawCircle(120, 120, 95, 5, WHITE);
             centered_text("Error", 95, WHITE, MEDIUM);
             centered_text(decode_error_number(lastError), 140, WHITE, TINY);
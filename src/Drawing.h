@@ -61,6 +61,8 @@ LGFX_Sprite* createPngBackground(const char* filename);
 
 void drawBackground(LGFX_Sprite* sprite);
 void drawBackground(int color);
+// Repaint the scene background, as drawn by system_background(), in one rectangle
+void drawBackground(int x, int y, int width, int height);
 void drawStatus();
 void drawStatusTiny(int y);
 void drawStatusSmall(int y);
@@ -97,6 +99,85 @@ void drawBatteryLevel(int x0, int y_bot);
 
 void refreshDisplay();
 
+// Damage tracking.  The drawing wrappers record the canvas area they touch;
+// refreshDisplay() pushes only the union of those areas and then clears it.
+// Code that draws on the canvas directly must call mark_dirty() itself.
+void mark_dirty(int x, int y, int width, int height);
+void mark_all_dirty();
+
+struct CanvasRect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+// For StaticLayer.  mark_restored() records an area that has been put back
+// to a snapshot: it is pushed, but does not count as drawn on.
+// take_canvas_damage() returns the bounding box of everything drawn since
+// the previous call, if anything was; canvas_damage_rects() returns the
+// areas in that box that were drawn on, other than DRO cells.
+void mark_restored(int x, int y, int width, int height);
+bool take_canvas_damage(CanvasRect& rect);
+int  canvas_damage_rects(const CanvasRect** rects);
+
+// For StaticLayer.  dro_keep_lines() returns the areas of the DRO lines
+// whose cells are on the canvas, so that a restore can leave them there;
+// dro_line_redrawn() says whether one of them has been drawn since.
+int  dro_keep_lines(CanvasRect* rects, int max);
+bool dro_line_redrawn(const CanvasRect& rect);
+
+// Bytes sent to the panel by the most recent refreshDisplay(), and in total
+uint32_t display_bytes_pushed();
+uint32_t display_bytes_pushed_total();
+
+// Display-list hash.  Every drawing wrapper folds its operation and its
+// arguments into a hash of the frame being built.  If a frame hashes the
+// same as the previous one, the scene has redrawn exactly what is already
+// on the panel, so refreshDisplay() skips the push.  Code that draws on the
+// canvas directly must call hash_draw() with whatever determines its pixels,
+// in addition to mark_dirty().
+enum draw_op_t {
+    OP_BACKGROUND = 1,
+    OP_FILLED_CIRCLE,
+    OP_CIRCLE,
+    OP_OUTLINED_CIRCLE,
+    OP_RECT,
+    OP_OUTLINED_RECT,
+    OP_PNG,
+    OP_SPRITE,
+    OP_TEXT,
+    OP_DRO_CELL,
+    OP_DRO_CLEAR,
+    OP_WIFI_BARS,
+    OP_BATTERY,
+    OP_JOG_DIAL,
+    OP_SCROLL_TRACK,
+    OP_IMAGE_BUTTON,
+    OP_STATIC_LAYER,
+    OP_BACKGROUND_RECT,
+};
+void hash_draw(draw_op_t op, int a = 0, int b = 0, int c = 0, int d = 0, int e = 0, int f = 0);
+void hash_draw(const char* str);
+
+// Pixels the hash cannot see, such as a sprite or a snapshot whose content
+// can change behind the same pointer, are hashed by a generation number
+// instead.  Whatever holds them takes a new number from
+// next_draw_generation() each time their content changes.
+uint32_t next_draw_generation();
+
+// Call after drawing into a sprite that is passed to drawBackground().
+// createPngBackground() does this itself.
+void sprite_changed(LGFX_Sprite* sprite);
+
+// The panel no longer shows the canvas, for example after a rotation or a
+// direct draw on the display; the next refreshDisplay() pushes everything.
+void invalidate_display();
+
+// Frames pushed to the panel, and frames skipped because nothing changed
+uint32_t display_frames_pushed();
+uint32_t display_frames_skipped();
+
 void drawError();
 
 extern Point sprite_offset;
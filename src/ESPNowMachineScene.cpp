@@ -230,7 +230,7 @@ void ESPNowMachineScene::reDisplay() {
             int detail_y = y + (round_display ? 29 : 23);
             int title_w  = bw - (title_x - bx) - 10;
 
-            auto_text(std::string(title), title_x, title_y, title_w,
+            auto_text(title, title_x, title_y, title_w,
                       sel ? WHITE : LIGHTGREY, SMALL, middle_left);
             centered_text(detail, detail_y + 4,
                           sel ? 0xcc66ff : DARKGREY, TINY);
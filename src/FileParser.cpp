@@ -7,6 +7,9 @@
 #include "Menu.h"
 #include "GrblParserC.h"  // send_line()
 #include "HomingScene.h"  // set_axis_homed()
+#include "Metrics.h"
+#include "SpanTrace.h"
+#include "HeapStats.h"
 
 #include <JsonStreamingParser.h>
 #include <JsonListener.h>
@@ -157,6 +160,7 @@ public:
         } else {
             return;
         }
+        HeapScope heap_scope(HEAP_MENU);
         macroMenu.addItem(new MacroItem { _name.c_str(), _filename });
     }
 
@@ -224,6 +228,7 @@ public:
             } else {
                 return;
             }
+            HeapScope heap_scope(HEAP_MENU);
             macroMenu.addItem(new MacroItem { _name.c_str(), _filename });
             return;
         }
@@ -314,6 +319,7 @@ public:
             } else {
                 return;
             }
+            HeapScope heap_scope(HEAP_MENU);
             macroMenu.addItem(new MacroItem { _name.c_str(), _filename });
             return;
         }
@@ -665,6 +671,7 @@ void request_file_preview(const char* name, int firstline, int nlines) {
 // when a document is complete and when the parser is safe to reset.
 
 static int  s_json_depth  = 0;
+static Counter s_json_documents("json.documents");
 static bool s_json_in_str = false;
 static bool s_json_esc    = false;
 
@@ -701,8 +708,8 @@ static void parser_feed_line(const char* line) {
             } else if (c == '{') {
                 s_json_depth++;
             } else if (c == '}') {
-                if (s_json_depth > 0) {
-                    s_json_depth--;
+                if (s_json_depth > 0 && --s_json_depth == 0) {
+                    ++s_json_documents;
                 }
             }
         }
@@ -711,6 +718,8 @@ static void parser_feed_line(const char* line) {
 }
 
 extern "C" void handle_json(const char* line) {
+    TRACE_SPAN("handle_json");
+    HeapScope heap_scope(HEAP_JSON);
 #ifdef FNC_RX_TRACE
     // Print depth + the leading 60 chars of the chunk so we can SEE the
     // wire format. Truncated to avoid drowning the monitor on large
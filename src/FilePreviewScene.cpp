@@ -71,7 +71,8 @@ public:
         }
     }
 
-    void onDROChange() { reDisplay(); }
+    void     onDROChange(uint32_t changes) { request_redisplay(); }
+    uint32_t modelInterest() override { return MODEL_STATE; }
 
     void onGreenButtonPress() {
         if (state == Idle) {
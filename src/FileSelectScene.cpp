@@ -4,6 +4,7 @@
 
 #include "Scene.h"
 #include "FileParser.h"
+#include "StaticLayer.h"
 #include "polar.h"
 
 // #define SMOOTH_SCROLL
@@ -25,6 +26,10 @@ private:
     int              dirLevel        = 0;
     bool             _selecting_file = false;
 
+    StaticLayer _static_layer;  // Background, title and scroll track
+
+    static const int scroll_width = 8;
+
     const char* format_size(size_t size) {
         const int   buflen = 30;
         static char buffer[buflen];
@@ -185,12 +190,38 @@ public:
         }
     }
 
+    // Scroll indicator track showing the position of the displayed files
+    // in the larger list of files.
+    void drawScrollTrack() {
+        int radius = scroll_width / 2;
+        if (round_display) {
+            for (int i = 0; i < scroll_width; i++) {
+                canvas.drawArc(120, 120, 119 - i, 115 - i, -50, 50, DARKGREY);
+            }
+            mark_dirty(120, 0, 120, 240);
+            hash_draw(OP_SCROLL_TRACK, scroll_width);
+        } else {
+            int x      = display_short_side() - scroll_width;
+            int height = display_short_side() - 30;
+            drawRect(x - radius, radius, scroll_width + 2, height, radius, DARKGREY);
+        }
+    }
+
     void showFiles() {
-        // canvas.createSprite(240, 240);
-        // drawBackground(BLACK);
-        background();
-        drawMenuTitle(current_scene->name());
-        std::string fName;
+        // If there are at most three files, all are displayed, without
+        // a scroll indicator.
+        bool show_track = fileVector.size() > 3;
+
+        // The static part only changes when the track appears or goes away
+        if (!_static_layer.restore(show_track)) {
+            background();
+            drawMenuTitle(current_scene->name());
+            if (show_track) {
+                drawScrollTrack();
+            }
+            _static_layer.save(show_track);
+        }
+        const char* fName;
 
         int fdIter = _selected_file - 1;  // first file in display list
 
@@ -214,7 +245,7 @@ public:
 
             fName = "< no files >";
             if (fileVector.size()) {
-                fName = fileVector[fdIter].fileName;
+                fName = fileVector[fdIter].fileName.c_str();
             }
             int middle_slot = (N_DISPLAYED_FILENAMES - 1) / 2;
             int offset      = middle_slot - display_slot;
@@ -222,35 +253,31 @@ public:
                 int tcolor = BLACK;
                 drawRect(Point(x_offset, 0), big_width, big_height, big_height * 45 / 100, LIGHTGREY);
 
-                std::string fInfoT = "";  // file info top line
-                std::string fInfoB = "";  // File info bottom line
-                int         ext    = fName.rfind('.');
+                const char* fInfoT = "";  // file info top line
+                const char* fInfoB = "";  // File info bottom line
+                const char* ext    = strrchr(fName, '.');
+                char        type[24];
+                char        base[128];
                 if (fileVector.size()) {
                     if (fileVector[_selected_file].isDir()) {
                         fInfoB = "Folder";
                         tcolor = BLUE;
                     } else {
-                        if (ext > 0) {
-                            fInfoT = fName.substr(ext, fName.length());
-                            fInfoT += " file";
-                            fName.erase(ext);
+                        if (ext && ext > fName) {
+                            snprintf(type, sizeof(type), "%s file", ext);
+                            snprintf(base, sizeof(base), "%.*s", (int)(ext - fName), fName);
+                            fInfoT = type;
+                            fName  = base;
                         }
                         fInfoB = format_size(fileVector[_selected_file].fileSize);
                     }
                 }
 
-                // Scroll indicator showing the position of the displayed files
-                // in the larger list of files.
-                // If there are at most three files, all are displayed, without
-                // a scroll indicator.
-                if (fileVector.size() > 3) {
-                    int width  = 8;
+                // Scroll thumb on the track drawn by drawScrollTrack()
+                if (show_track) {
+                    int width  = scroll_width;
                     int radius = width / 2;
                     if (round_display) {
-                        for (int i = 0; i < width; i++) {
-                            canvas.drawArc(120, 120, 119 - i, 115 - i, -50, 50, DARKGREY);
-                        }
-
                         int x, y;
                         int arc_degrees = 100;
                         int divisor     = fileVector.size() - 1;
@@ -266,13 +293,12 @@ public:
                         int middle       = inner_height / 2;
                         int divisor      = fileVector.size() - 1;
                         int y            = width + inner_height * _selected_file / divisor;
-                        drawRect(x - radius, radius, width + 2, height, radius, DARKGREY);
                         drawFilledCircle(x, y, radius + 1, LIGHTGREY);
                     }
                 }
 
-                text(fInfoT.c_str(), Point(x_offset, type_offset), BLUE, SMALL, middle_center);
-                text(fInfoB.c_str(), Point(x_offset, size_offset), BLACK, TINY, middle_center);
+                text(fInfoT, Point(x_offset, type_offset), BLUE, SMALL, middle_center);
+                text(fInfoB, Point(x_offset, size_offset), BLACK, TINY, middle_center);
 
                 auto_text(fName, Point(x_offset, 0), fnlayout._w, tcolor, MEDIUM, middle_center);
 
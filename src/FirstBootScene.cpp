@@ -121,7 +121,7 @@ public:
         };
         int dot_x = (BTN_X - SEL_EXPAND) - DOT_OFFSET;
         int dot_y = sel_ys[_selected] + BTN_H / 2;
-        canvas.fillCircle(dot_x, dot_y, DOT_R, WHITE);
+        drawFilledCircle(dot_x, dot_y, DOT_R, WHITE);
 
         // if (!round_display) {
         //     centered_text("This can be changed later", 218, DARKGREY, TINY);
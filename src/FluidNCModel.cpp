@@ -10,6 +10,10 @@
 #include "e4math.h"
 #include "HomingScene.h"
 #include "BootLog.h"
+#include "JogLatency.h"
+#include "SpanTrace.h"
+#include "AllocProfile.h"
+#include "Metrics.h"
 
 #ifdef USE_WIFI
 #    include "WiFiConnection.h"  // wifi_use_uart_mode()
@@ -33,7 +37,24 @@ uint32_t           myFeed             = 0;
 uint32_t           mySpeed            = 0;
 uint32_t           mySelectedTool     = 0;
 
-std::string myModes = "no data";
+char myModes[64] = "no data";
+
+static char ctrl_pins[32] = "";  // myCtrlPins points here
+
+static uint32_t model_changes  = 0;      // Parts changed since the last status report
+static bool     report_percent = false;  // The current report had a file percentage
+static Counter  unchanged_reports("model.unchanged_reports");
+
+static int report_interval = 0;  // Last $RI sent, 0 if none since connecting
+
+// Store value in field, marking part changed if that is different
+template <typename T, typename V>
+static void model_set(T& field, V value, uint32_t part) {
+    if (field != (T)value) {
+        field = (T)value;
+        model_changes |= part;
+    }
+}
 
 int      lastAlarm = 0;
 int      lastError = 0;
@@ -79,9 +100,16 @@ bool decode_state_string(const char* state_string, state_t& state) {
     return false;
 }
 
+static void forget_unanswered_lines();
+
 void set_disconnected_state() {
+    if (state != Disconnected) {
+        model_changes |= MODEL_STATE;
+    }
     state           = Disconnected;
     my_state_string = "N/C";
+    report_interval = 0;  // FluidNC forgets it; send it again on reconnecting
+    forget_unanswered_lines();
 }
 
 // clang-format off
@@ -112,43 +140,98 @@ const char* decode_error_number(int error_num) {
     return retval;
 }
 
+// DRO extrapolation; see dro_axis()
+static pos_t    dro_delta[6]    = { 0 };  // Movement between the last two reports
+static uint32_t dro_report_ms   = 0;      // Arrival of the last report
+static uint32_t dro_interval_ms = 0;      // Time between the last two reports, 0 if unusable
+static bool     dro_inches      = false;  // Units of the last report
+
+// Estimate the axis velocities from a report's positions, before they are stored
+static void dro_track(const pos_t* axes, int n_axis) {
+    uint32_t now      = milliseconds();
+    uint32_t interval = now - dro_report_ms;
+    bool     usable   = interval > 0 && interval <= DRO_EXTRAPOLATE_MAX_MS && inInches == dro_inches;
+    dro_interval_ms   = 0;
+    for (int axis = 0; axis < n_axis; axis++) {
+        dro_delta[axis] = usable ? axes[axis] - myAxes[axis] : 0;
+        if (dro_delta[axis] != 0) {
+            dro_interval_ms = interval;
+        }
+    }
+    dro_report_ms = now;
+    dro_inches    = inInches;
+}
+
+bool dro_extrapolating() {
+    return dro_interval_ms && (state == Cycle || state == Jog);
+}
+
+pos_t dro_axis(int axis) {
+    if (!dro_extrapolating()) {
+        return myAxes[axis];
+    }
+    // Never more than one report ahead, so a stop overshoots by at most that
+    uint32_t elapsed = milliseconds() - dro_report_ms;
+    if (elapsed > dro_interval_ms) {
+        elapsed = dro_interval_ms;
+    }
+#ifdef E4_POS_T
+    return myAxes[axis] + (pos_t)((int64_t)dro_delta[axis] * elapsed / dro_interval_ms);
+#else
+    return myAxes[axis] + dro_delta[axis] * elapsed / dro_interval_ms;
+#endif
+}
+
 extern "C" void begin_status_report() {
-    myPercent = 0;
+    alloc_profile_report_begin();
+    report_percent = false;
 }
 
 extern "C" void show_file(const char* filename, file_percent_t percent) {
-    myPercent = percent;
+    model_set(myPercent, percent, MODEL_FILE);
+    report_percent = true;
 }
 
 extern "C" void show_overrides(override_percent_t feed_ovr, override_percent_t rapid_ovr, override_percent_t spindle_ovr) {
-    myFro = feed_ovr;
-    mySro = spindle_ovr;
+    model_set(myFro, feed_ovr, MODEL_OVERRIDES);
+    model_set(mySro, spindle_ovr, MODEL_OVERRIDES);
 }
 
 extern "C" void show_feed_spindle(uint32_t feedrate, uint32_t spindle_speed) {
-    myFeed  = feedrate;
-    mySpeed = spindle_speed;
+    model_set(myFeed, feedrate, MODEL_FEED);
+    model_set(mySpeed, spindle_speed, MODEL_FEED);
 };
 
 extern "C" void show_limits(bool probe, const bool* limits, size_t n_axis) {
-    myProbeSwitch = probe;
-    memcpy(myLimitSwitches, limits, n_axis * sizeof(*limits));
+    model_set(myProbeSwitch, probe, MODEL_LIMITS);
+    for (size_t axis = 0; axis < n_axis; axis++) {
+        model_set(myLimitSwitches[axis], limits[axis], MODEL_LIMITS);
+    }
 }
 
 extern "C" void show_control_pins(const char* pins) {
     //dbg_printf("show_control_pins:%s\r\n", pins);
-    myCtrlPins = pins;
+    if (strcmp(ctrl_pins, pins) != 0) {
+        snprintf(ctrl_pins, sizeof(ctrl_pins), "%s", pins);
+        model_changes |= MODEL_PINS;
+    }
+    myCtrlPins = ctrl_pins;
 }
 
 #ifdef E4_POS_T
 extern "C" void show_dro(const pos_t* axes, const pos_t* wco, bool isMpos, bool* limits, size_t n_axis) {
-    n_axes = (int)n_axis;
+    pos_t new_axes[6];
     for (int axis = 0; axis < n_axis; axis++) {
         e4_t axis_val = axes[axis];
         if (isMpos) {
             axis_val -= wco[axis];
         }
-        myAxes[axis] = inInches ? e4_mm_to_inch(axis_val) : axis_val;
+        new_axes[axis] = inInches ? e4_mm_to_inch(axis_val) : axis_val;
+    }
+    dro_track(new_axes, (int)n_axis);
+    model_set(n_axes, (int)n_axis, MODEL_AXES);
+    for (int axis = 0; axis < n_axis; axis++) {
+        model_set(myAxes[axis], new_axes[axis], MODEL_AXES);
     }
 }
 #else
@@ -160,22 +243,79 @@ pos_t toMm(pos_t position) {
 }
 
 extern "C" void show_dro(const pos_t* axes, const pos_t* wco, bool isMpos, bool* limits, size_t n_axis) {
+    pos_t new_axes[6];
     for (int axis = 0; axis < n_axis; axis++) {
-        myAxes[axis] = fromMm(axes[axis]);
+        new_axes[axis] = fromMm(axes[axis]);
         if (isMpos) {
-            myAxes[axis] -= fromMm(wco[axis]);
+            new_axes[axis] -= fromMm(wco[axis]);
         }
     }
+    dro_track(new_axes, (int)n_axis);
+    for (int axis = 0; axis < n_axis; axis++) {
+        model_set(myAxes[axis], new_axes[axis], MODEL_AXES);
+    }
 }
 #endif
 
+static volatile int      s_jog_inflight     = 0;
+static uint32_t          s_jog_inflight_ms  = 0;  // last send/ack — for stale recovery
+static const uint32_t    JOG_INFLIGHT_STALE_MS = 300;
+
+// FluidNC answers every line with "ok" or "error:N", in order.  This ring
+// holds whether each unanswered line was a jog, oldest first, so that only
+// the answers to jog lines count against s_jog_inflight.
+static const int MAX_UNANSWERED = 16;
+static bool      unanswered_jog[MAX_UNANSWERED];
+static int       unanswered_head  = 0;
+static int       unanswered_count = 0;
+
+// Record a line about to be sent.  Called before sending, because on the
+// UART the answer arrives before fnc_send_line() returns.
+static void line_sent(bool jog) {
+    if (unanswered_count == MAX_UNANSWERED) {  // Lost answers; forget the oldest
+        unanswered_head = (unanswered_head + 1) % MAX_UNANSWERED;
+        --unanswered_count;
+    }
+    unanswered_jog[(unanswered_head + unanswered_count++) % MAX_UNANSWERED] = jog;
+}
+
+// An answer arrived; returns whether it was for a jog line
+static bool line_answered() {
+    if (!unanswered_count) {
+        return false;
+    }
+    bool jog        = unanswered_jog[unanswered_head];
+    unanswered_head = (unanswered_head + 1) % MAX_UNANSWERED;
+    --unanswered_count;
+    return jog;
+}
+
+// The jogs still awaiting answers no longer count, but their answers must
+// still be consumed in order
+static void forget_unanswered_jogs() {
+    for (int i = 0; i < unanswered_count; i++) {
+        unanswered_jog[(unanswered_head + i) % MAX_UNANSWERED] = false;
+    }
+}
+
+// Nothing sent before a disconnect will be answered
+static void forget_unanswered_lines() {
+    unanswered_count = 0;
+}
+
 void send_line(const char* s, int timeout) {
+    TRACE_SPAN("send_line");
+    line_sent(false);
     fnc_send_line(s, timeout);
     dbg_println(s);
 }
 
 // Send a jog command over a networked transport without the per-line "ok" handshake.
 void send_jog_line(const char* s) {
+    TRACE_SPAN("send_jog_line");
+    line_sent(true);
+    ++s_jog_inflight;
+    s_jog_inflight_ms = milliseconds();
 #ifdef USE_WIFI
     if (!wifi_use_uart_mode()) {  // WiFi / Telnet / ESP-NOW: stream, no ack-gate
         for (const char* p = s; *p; ++p) {
@@ -186,26 +326,33 @@ void send_jog_line(const char* s) {
         return;
     }
 #endif
-    send_line(s);
+    fnc_send_line(s, 2000);
+    dbg_println(s);
 }
 
-static volatile int      s_jog_inflight     = 0;
-static uint32_t          s_jog_inflight_ms  = 0;  // last send/ack — for stale recovery
-static const uint32_t    JOG_INFLIGHT_STALE_MS = 300;
-
-void jog_mark_sent() {
-    ++s_jog_inflight;
-    s_jog_inflight_ms = milliseconds();
-}
 void jog_reset_inflight() {
-    s_jog_inflight = 0;
+    s_jog_inflight  = 0;
+    dro_interval_ms = 0;  // Stopping or reversing; hold the DRO at the last report
+    forget_unanswered_jogs();
+    jog_latency_cancel();
 }
 int jog_inflight() {
     if (s_jog_inflight > 0 && (milliseconds() - s_jog_inflight_ms) > JOG_INFLIGHT_STALE_MS) {
         s_jog_inflight = 0;  // ack(s) presumed lost / FluidNC quiet — recover
+        forget_unanswered_jogs();
+        jog_latency_cancel();
     }
     return s_jog_inflight;
 }
+
+// A jog line was answered, with "ok" or an error
+static void jog_answered() {
+    jog_latency_ok();
+    if (s_jog_inflight > 0) {
+        --s_jog_inflight;
+        s_jog_inflight_ms = milliseconds();
+    }
+}
 static void vsend_linef(const char* fmt, va_list va) {
     static char buf[128];
     vsnprintf(buf, 128, fmt, va);
@@ -235,12 +382,51 @@ const char* intToCStr(int val) {
 }
 
 const char* mode_string() {
-    return myModes.c_str();
+    return myModes;
 }
 
 state_t previous_state;
 bool    awaiting_alarm = false;
 
+static int      report_wanted   = 0;  // A slower interval waiting out REPORT_SLOWDOWN_MS
+static uint32_t report_wanted_ms;
+static Gauge    report_gauge("model.report_ms", [] { return (int32_t)report_interval; });
+
+int report_interval_ms() {
+    return report_interval;
+}
+
+void service_report_interval() {
+    if (state == Disconnected) {
+        return;
+    }
+    int want = current_scene->reportInterval();
+#ifdef USE_WIFI
+    // Fewer reports over the air while nobody is using the pendant
+    if (!wifi_use_uart_mode() && state == Idle && want >= REPORT_SLOW_MS &&
+        (uint32_t)(milliseconds() - last_input_ms()) >= REPORT_UNATTENDED_AFTER_MS) {
+        want = REPORT_UNATTENDED_MS;
+    }
+#endif
+    if (want == report_interval) {
+        report_wanted = 0;
+        return;
+    }
+    if (report_interval && want > report_interval) {
+        if (want != report_wanted) {
+            report_wanted    = want;
+            report_wanted_ms = milliseconds();
+            return;
+        }
+        if ((uint32_t)(milliseconds() - report_wanted_ms) < REPORT_SLOWDOWN_MS) {
+            return;
+        }
+    }
+    report_interval = want;
+    report_wanted   = 0;
+    send_linef("$RI=%d", want);
+}
+
 // Called once when status report received after being disconnected.
 // Use schedule_action() to defer execution to dispatch_events() in the main loop where the parser is idle and _report is clean.
 static void connect_init() {
@@ -250,7 +436,6 @@ static void connect_init() {
     fnc_realtime((realtime_cmd_t)0x0c);  // Ctrl-L - echo off (UART only)
 #endif
     send_line("$G");                     // Refresh GCode modes
-    send_line("$RI=200");                // Enable auto-reporting every 200 ms
 
     // Pre-populate the SD file list on the FIRST connect only. Re-fetching it
     // on every reconnect is both wasteful and harmful over ESP-NOW
@@ -263,6 +448,7 @@ static void connect_init() {
 }
 
 extern "C" void show_state(const char* state_string) {
+    TRACE_SPAN("show_state");
     previous_state = state;
     state_t new_state;
     if (decode_state_string(state_string, new_state) && state != new_state) {
@@ -270,6 +456,7 @@ extern "C" void show_state(const char* state_string) {
             schedule_action(connect_init);
         }
         state = new_state;
+        model_changes |= MODEL_STATE;
         if (state == Alarm && lastAlarm == 0) {  // Unknown
             send_line("$A");                     // Get last alarm
             awaiting_alarm = true;
@@ -279,6 +466,7 @@ extern "C" void show_state(const char* state_string) {
 }
 
 extern "C" void handle_other(char* line) {
+    TRACE_SPAN("handle_other");
     // $-responses are config, never JSON. If FluidNC tore down a JSON
     // document by sending a $-response (rare, but happens on some error
     // paths), drop the depth counter so the next document starts clean.
@@ -315,6 +503,9 @@ extern "C" void show_error(int error) {
 #ifdef FNC_RX_TRACE
     dbg_printf("[rx-err] error:%d\n", error);
 #endif
+    if (line_answered()) {
+        jog_answered();
+    }
     errorExpire = milliseconds() + 1000;
     lastError   = error;
     if (json_in_progress()) {
@@ -332,13 +523,12 @@ extern "C" void show_timeout() {
     dbg_println("Timeout");
 }
 extern "C" void show_ok() {
+    TRACE_SPAN("show_ok");
 #ifdef FNC_RX_TRACE
     dbg_printf("[rx-ok]\n");
 #endif
-    
-    if (s_jog_inflight > 0) {
-        --s_jog_inflight;
-        s_jog_inflight_ms = milliseconds();
+    if (line_answered()) {
+        jog_answered();
     }
     if (json_in_progress()) {
         // "ok" ends a reply; if a torn JSON doc was in flight, clean up.
@@ -347,7 +537,20 @@ extern "C" void show_ok() {
 }
 
 extern "C" void end_status_report() {
-    current_scene->onDROChange();
+    if (!report_percent) {
+        model_set(myPercent, 0, MODEL_FILE);
+    }
+    jog_latency_report();
+    // A report that changed nothing the scene shows costs nothing here
+    uint32_t changes = model_changes & current_scene->modelInterest();
+    model_changes    = 0;
+    if (changes) {
+        TRACE_SPAN_DETAIL("onDROChange", current_scene->name());
+        current_scene->onDROChange(changes);
+    } else {
+        ++unchanged_reports;
+    }
+    alloc_profile_report_end();
 }
 
 extern "C" void show_alarm(int alarm) {
@@ -356,23 +559,24 @@ extern "C" void show_alarm(int alarm) {
 }
 
 extern "C" void show_gcode_modes(struct gcode_modes* modes) {
-    inInches = strcmp(modes->units, "In") == 0 || strcmp(modes->units, "G20") == 0;
-
-    myModes = modes->wcs;
-    myModes += " ";
-    myModes += modes->units;
-    myModes += " ";
-    myModes += modes->distance;
-    myModes += " ";
-    myModes += modes->spindle;
-    if (strcmp(modes->mist, "On") == 0) {
-        myModes += " Mist";
-    }
-    if (strcmp(modes->flood, "On") == 0) {
-        myModes += " Flood";
+    model_set(inInches, strcmp(modes->units, "In") == 0 || strcmp(modes->units, "G20") == 0, MODEL_MODES);
+
+    char new_modes[sizeof(myModes)];
+    snprintf(new_modes,
+             sizeof(new_modes),
+             "%s %s %s %s%s%s",
+             modes->wcs,
+             modes->units,
+             modes->distance,
+             modes->spindle,
+             strcmp(modes->mist, "On") == 0 ? " Mist" : "",
+             strcmp(modes->flood, "On") == 0 ? " Flood" : "");
+    if (strcmp(myModes, new_modes) != 0) {
+        strcpy(myModes, new_modes);
+        model_changes |= MODEL_MODES;
     }
 
-    mySelectedTool = modes->tool;
+    model_set(mySelectedTool, modes->tool, MODEL_MODES);
     request_redisplay();
 }
 
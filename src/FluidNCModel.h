@@ -44,13 +44,70 @@ extern uint32_t           errorExpire;
 extern bool               inInches;
 extern uint32_t           mySelectedTool;
 
+// Parts of the model, as bits in the change masks passed to
+// Scene::onDROChange().  Each show_*() callback compares what the parser
+// gives it with the stored value and marks the part only if it differs;
+// end_status_report() delivers the parts changed since the last report,
+// restricted to the current scene's modelInterest(), in one call.
+enum model_part_t : uint32_t {
+    MODEL_STATE     = 1 << 0,  // state, my_state_string
+    MODEL_AXES      = 1 << 1,  // myAxes, n_axes
+    MODEL_LIMITS    = 1 << 2,  // myLimitSwitches, myProbeSwitch
+    MODEL_PINS      = 1 << 3,  // myCtrlPins
+    MODEL_FILE      = 1 << 4,  // myPercent
+    MODEL_OVERRIDES = 1 << 5,  // myFro, mySro
+    MODEL_FEED      = 1 << 6,  // myFeed, mySpeed
+    MODEL_MODES     = 1 << 7,  // mode_string(), inInches, mySelectedTool
+    MODEL_ALL       = 0xff,
+};
+
+// The DRO between status reports.  show_dro() estimates each axis' velocity
+// from the last two reports and their arrival times; in Cycle and Jog,
+// dro_axis() extrapolates myAxes[axis] by up to one report interval from
+// the last report, which it snaps back to.  In other states, or when the
+// reports are more than DRO_EXTRAPOLATE_MAX_MS apart, it is myAxes[axis].
+#ifndef DRO_EXTRAPOLATE_MAX_MS
+#    define DRO_EXTRAPOLATE_MAX_MS 1000
+#endif
+
+pos_t dro_axis(int axis);
+bool  dro_extrapolating();
+
+// FluidNC's auto-report interval ($RI), chosen by the current scene's
+// reportInterval() and sent from dispatch_events() by
+// service_report_interval().  A faster interval is sent at once; a slower
+// one only after it has been wanted for REPORT_SLOWDOWN_MS, so brief state
+// and scene changes do not each send a $RI.  On a network transport with
+// the machine Idle and no input for REPORT_UNATTENDED_AFTER_MS, the slow
+// interval stretches to REPORT_UNATTENDED_MS.
+#ifndef REPORT_FAST_MS
+#    define REPORT_FAST_MS 100  // Jogging, homing, probing
+#endif
+#ifndef REPORT_NORMAL_MS
+#    define REPORT_NORMAL_MS 200  // A DRO on screen, or the machine moving
+#endif
+#ifndef REPORT_SLOW_MS
+#    define REPORT_SLOW_MS 1000  // Menus and lists with the machine idle
+#endif
+#ifndef REPORT_UNATTENDED_MS
+#    define REPORT_UNATTENDED_MS 1500  // Well under WIFI_RX_STALL_MS, or the socket is dropped
+#endif
+#ifndef REPORT_UNATTENDED_AFTER_MS
+#    define REPORT_UNATTENDED_AFTER_MS 60000
+#endif
+#ifndef REPORT_SLOWDOWN_MS
+#    define REPORT_SLOWDOWN_MS 2000
+#endif
+
+void service_report_interval();
+int  report_interval_ms();  // The interval last sent, 0 if none since connecting
+
 int num_digits();
 
 void send_line(const char* s, int timeout = 2000);
 void send_jog_line(const char* s);  // jog send without the "ok" handshake
 void send_linef(const char* fmt, ...);
 
-void jog_mark_sent();       // record that a jog line was just streamed
 int  jog_inflight();        // jogs sent but not yet acked (self-heals if stalled)
 void jog_reset_inflight();  // clear (on JogCancel / jog stop)
 
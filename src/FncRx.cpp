@@ -0,0 +1,74 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "FncRx.h"
+#include "FluidNCModel.h"  // update_rx_time()
+#include "FncTrace.h"
+#include <cstring>
+
+static const uint8_t* rx_data = nullptr;
+static size_t         rx_pos  = 0;
+static size_t         rx_len  = 0;
+
+extern "C" int fnc_getchar() {
+    if (rx_pos == rx_len) {
+        if (rx_len) {
+            fnc_rx_release(rx_len);
+        }
+        rx_pos = 0;
+        rx_len = fnc_rx_slice(&rx_data);
+        if (!rx_len) {
+            return -1;
+        }
+        update_rx_time();
+#ifdef ARDUINO
+        // Host builds replay traces rather than record them
+        for (size_t i = 0; i < rx_len; i++) {
+            trace_rx(rx_data[i]);
+        }
+#endif
+    }
+    return rx_data[rx_pos++];
+}
+
+// Whether another received byte is ready, in the slice or still in the transport
+extern "C" bool fnc_rx_waiting() {
+    return rx_pos < rx_len || transport_rx_waiting();
+}
+
+// Only one transport is active at a time, so one staging buffer serves them all
+static uint8_t stage[FNC_RX_SPAN];
+static size_t  stage_pos = 0;
+static size_t  stage_len = 0;
+
+size_t rx_stage_slice(size_t (*read)(uint8_t* buf, size_t max), const uint8_t** data) {
+    if (stage_pos == stage_len) {
+        stage_pos = 0;
+        stage_len = read(stage, sizeof(stage));
+    }
+    *data = stage + stage_pos;
+    return stage_len - stage_pos;
+}
+
+void rx_stage_release(size_t n) {
+    stage_pos += n;
+}
+
+size_t strip_cr(uint8_t* p, size_t n) {
+    uint8_t* end = p + n;
+    uint8_t* out = (uint8_t*)memchr(p, '\r', n);
+    if (!out) {
+        return n;
+    }
+    // Slide each run between CRs down over the CRs already dropped
+    for (uint8_t* in = out + 1; in < end;) {
+        uint8_t* cr  = (uint8_t*)memchr(in, '\r', end - in);
+        size_t   run = (cr ? cr : end) - in;
+        memmove(out, in, run);
+        out += run;
+        if (!cr) {
+            break;
+        }
+        in = cr + 1;
+    }
+    return out - p;
+}
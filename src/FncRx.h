@@ -0,0 +1,53 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Bytes received from FluidNC, read in place a slice at a time.
+//
+// GrblParser's fnc_poll() assembles lines itself and asks for one byte per
+// call through fnc_getchar().  Rather than going to the transport for each
+// of those bytes, fnc_getchar() reads them straight out of a contiguous
+// slice of the transport's own buffer - the Telnet or ESP-NOW ring, or the
+// replayed trace - and releases the slice once it has all been read.  The
+// bytes are copied once on the way in (by the socket or the radio
+// callback, with CRs dropped as they land in the ring) and once more into
+// GrblParser's line buffer, and nowhere else.
+//
+// The UART driver and the host serial ports can only copy bytes out, so
+// they fill a staging buffer of FNC_RX_SPAN bytes with one bulk read and
+// hand that out as the slice (rx_stage_slice()).
+//
+// FNC_TRACE recording and the link timeout are handled here once per slice;
+// the per-transport byte counters are in fnc_rx_slice().
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef FNC_RX_SPAN
+#    define FNC_RX_SPAN 256
+#endif
+
+// Most bytes loop() feeds to fnc_poll() in one iteration
+#ifndef FNC_RX_DRAIN
+#    define FNC_RX_DRAIN 512
+#endif
+
+// Provided by the System*.cpp for the build: point data at the oldest
+// received bytes that are contiguous in memory and return how many there
+// are, 0 if none.  The bytes stay buffered until fnc_rx_release().
+size_t fnc_rx_slice(const uint8_t** data);
+
+// Provided by the System*.cpp: the first n bytes of the slice have been read
+void fnc_rx_release(size_t n);
+
+// Provided by the System*.cpp: true if the transport has bytes buffered
+bool transport_rx_waiting();
+
+// Slice and release for transports that can only copy bytes out: read()
+// fills the staging buffer when it is empty, without blocking
+size_t rx_stage_slice(size_t (*read)(uint8_t* buf, size_t max), const uint8_t** data);
+void   rx_stage_release(size_t n);
+
+// Drop the CRs from p[0..n) in place, returning the new length; FluidNC
+// ends lines with CRLF over the network but GrblParser wants LF only
+size_t strip_cr(uint8_t* p, size_t n);
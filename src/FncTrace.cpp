@@ -0,0 +1,265 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "FncTrace.h"
+
+#ifdef FNC_TRACE
+#    include "System.h"
+#    include "FluidNCModel.h"
+#    include "LoopProfile.h"
+#    include "AllocProfile.h"
+#    include "JogLatency.h"
+#    include "Metrics.h"
+#    include <cstring>
+#    include <cstdio>
+#    ifndef ARDUINO
+#        include <vector>
+#        include <chrono>
+#    endif
+
+static const char    trace_magic[]  = "FNCT";
+static const uint8_t trace_version  = 1;
+static const int     max_run        = 0x7f;
+static const size_t  no_record      = (size_t)-1;
+static const int     max_header_len = 1 + 5;  // Header byte and the longest varint
+
+static uint8_t  ring[FNC_TRACE_RING];
+static size_t   head     = 0;  // Where the next byte goes
+static size_t   tail     = 0;  // Start of the oldest record
+static size_t   used     = 0;
+static size_t   open_rec = no_record;  // Header of the record still being extended
+static bool     open_tx  = false;
+static uint32_t last_ms  = 0;
+static bool     enabled  = true;
+
+static uint8_t ring_at(size_t i) {
+    return ring[(tail + i) % FNC_TRACE_RING];
+}
+
+static void put(uint8_t b) {
+    ring[head] = b;
+    head       = (head + 1) % FNC_TRACE_RING;
+    ++used;
+}
+
+static void drop_oldest() {
+    if (tail == open_rec) {
+        open_rec = no_record;
+    }
+    size_t len = 1;
+    while (ring_at(len++) & 0x80) {}  // Skip the delta varint
+    len += ring_at(0) & max_run;
+    tail = (tail + len) % FNC_TRACE_RING;
+    used -= len;
+}
+
+static void make_room(size_t n) {
+    while (used && FNC_TRACE_RING - used < n) {
+        drop_oldest();
+    }
+}
+
+static void record(bool tx, uint8_t c) {
+    if (!enabled) {
+        return;
+    }
+    uint32_t now = milliseconds();
+    if (open_rec != no_record && tx == open_tx && now == last_ms && (ring[open_rec] & max_run) < max_run) {
+        make_room(1);
+        if (open_rec != no_record) {
+            ++ring[open_rec];
+            put(c);
+            return;
+        }
+    }
+    make_room(max_header_len + 1);
+    uint32_t delta = now - last_ms;
+    last_ms        = now;
+    open_rec       = head;
+    open_tx        = tx;
+    put((tx ? 0x80 : 0) | 1);
+    while (delta >= 0x80) {
+        put((delta & 0x7f) | 0x80);
+        delta >>= 7;
+    }
+    put(delta);
+    put(c);
+}
+
+void trace_rx(uint8_t c) {
+    record(false, c);
+}
+void trace_tx(uint8_t c) {
+    record(true, c);
+}
+void trace_enable(bool on) {
+    enabled = on;
+}
+
+#    ifdef ARDUINO
+bool trace_save(const char* path) {
+    File f = LittleFS.open(path, "w");
+    if (!f) {
+        return false;
+    }
+    f.write((const uint8_t*)trace_magic, 4);
+    f.write(&trace_version, 1);
+    for (size_t i = 0; i < used; i++) {
+        f.write(ring_at(i));
+    }
+    f.close();
+    dbg_printf("Saved %u trace bytes to %s\n", (unsigned)used, path);
+    return true;
+}
+#    else
+bool trace_save(const char* path) {
+    if (*path == '/') {
+        ++path;  // Relative to the current directory, like the prefs
+    }
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    fwrite(trace_magic, 1, 4, f);
+    fwrite(&trace_version, 1, 1, f);
+    for (size_t i = 0; i < used; i++) {
+        fputc(ring_at(i), f);
+    }
+    fclose(f);
+    dbg_printf("Saved %u trace bytes to %s\n", (unsigned)used, path);
+    return true;
+}
+
+// Replay state.  fnc_getchar() reads received bytes in place from the
+// trace; taking the next record advances the virtual clock by the recorded
+// delay, so a blocking wait for "ok" sees exactly the delay that was
+// recorded.
+static bool                 replaying   = false;
+static uint32_t             replay_ms   = 0;  // Session time replayed so far
+static std::vector<uint8_t> replay_trace;
+static size_t               replay_pos  = 0;
+static const uint8_t*       rx_data     = nullptr;
+static size_t               rx_left     = 0;
+static uint32_t             records     = 0;
+static uint32_t             rx_bytes    = 0;
+static uint32_t             tx_recorded = 0;
+static uint32_t             tx_produced = 0;
+
+// Advance to the next record of received bytes; false at the end of the trace
+static bool next_rx_record() {
+    while (replay_pos < replay_trace.size()) {
+        uint8_t  header = replay_trace[replay_pos++];
+        uint32_t delta  = 0;
+        int      shift  = 0;
+        while (replay_pos < replay_trace.size()) {
+            uint8_t b = replay_trace[replay_pos++];
+            delta |= (uint32_t)(b & 0x7f) << shift;
+            shift += 7;
+            if (!(b & 0x80)) {
+                break;
+            }
+        }
+        size_t n = header & max_run;
+        if (replay_pos + n > replay_trace.size()) {
+            dbg_printf("Trace truncated at byte %u\n", (unsigned)replay_pos);
+            replay_pos = replay_trace.size();
+            return false;
+        }
+        ++records;
+        replay_ms += delta;
+        clock_advance_ms(delta);
+        if (header & 0x80) {
+            tx_recorded += n;
+            replay_pos += n;
+            continue;
+        }
+        rx_data = &replay_trace[replay_pos];
+        rx_left = n;
+        rx_bytes += n;
+        replay_pos += n;
+        return true;
+    }
+    return false;
+}
+
+bool trace_replaying() {
+    return replaying;
+}
+// One record at a time, so the clock advances between them as recorded
+size_t trace_replay_slice(const uint8_t** data) {
+    if (!rx_left && !next_rx_record()) {
+        clock_advance_ms(1);  // Nothing more will arrive; let timeouts expire
+        return 0;
+    }
+    *data = rx_data;
+    return rx_left;
+}
+void trace_replay_release(size_t n) {
+    rx_data += n;
+    rx_left -= n;
+}
+void trace_replay_putchar(uint8_t c) {
+    ++tx_produced;
+}
+extern void loop();
+
+// Run on past the end of the trace with nothing more arriving.  Returns
+// nonzero if the link is never declared lost.
+static int replay_silence() {
+    if (state == Disconnected) {
+        dbg_printf("Replay ended disconnected\n");
+        replaying = false;
+        return 0;
+    }
+    uint32_t silent_ms = 0;
+    while (state != Disconnected && silent_ms < TRACE_REPLAY_SILENCE_MS) {
+        clock_fast_forward(100);
+        silent_ms += 100;
+    }
+    replaying = false;
+    if (state != Disconnected) {
+        dbg_printf("Link still up after %u ms of silence\n", silent_ms);
+        return 1;
+    }
+    dbg_printf("Link declared lost after %u ms of silence\n", silent_ms);
+    return 0;
+}
+
+int trace_replay(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        dbg_printf("Can't open %s\n", path);
+        return 1;
+    }
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        replay_trace.push_back(c);
+    }
+    fclose(f);
+    if (replay_trace.size() < 5 || memcmp(replay_trace.data(), trace_magic, 4) != 0 || replay_trace[4] != trace_version) {
+        dbg_printf("%s is not a version %d trace\n", path, trace_version);
+        return 1;
+    }
+
+    enabled    = false;  // Don't record the replay
+    replaying  = true;
+    replay_pos = 5;
+    clock_set_virtual(true);
+
+    auto start = std::chrono::steady_clock::now();
+    while (rx_left || replay_pos < replay_trace.size()) {
+        loop();
+    }
+    loop();  // Let a pending redisplay run
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    dbg_printf("Replayed %u records, %u ms of session time\n", records, replay_ms);
+    dbg_printf("RX %u bytes in %.3f s: %.0f bytes/s\n", rx_bytes, seconds, seconds > 0 ? rx_bytes / seconds : 0.0);
+    dbg_printf("TX %u bytes recorded, %u bytes produced by the replay\n", tx_recorded, tx_produced);
+    loop_profile_dump();
+    alloc_profile_dump();
+    jog_latency_export();
+    metrics_dump();
+    return replay_silence();
+}
+#    endif
+#endif
@@ -0,0 +1,75 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// FluidNC link trace recorder and replayer.
+//
+// Built with -DFNC_TRACE.  Every byte that crosses the fnc_getchar() /
+// fnc_putchar() boundary, whichever transport is active (UART, WebSocket
+// or ESP-NOW), is recorded with a millisecond timestamp into a RAM ring of
+// FNC_TRACE_RING bytes.  When the ring is full the oldest records are
+// dropped, so the ring always holds the most recent part of the session.
+// trace_save() writes it to a file: LittleFS on the pendant (CTRL-T on the
+// debug port), the current directory on host builds.
+//
+// The file is "FNCT", a version byte, then a sequence of records:
+//
+//   header   bit 7: 1 = sent by the pendant, 0 = received from FluidNC
+//            bits 0-6: number of data bytes, 1..127
+//   delta    milliseconds since the previous record, LEB128 varint
+//   data     the bytes
+//
+// Consecutive bytes in the same direction and the same millisecond share a
+// record, so a status report costs about three bytes of overhead.
+//
+// On host builds, trace_replay() feeds the received bytes of a trace back
+// through fnc_poll() and the main loop on the virtual clock (see Clock.h),
+// which follows the recorded timestamps instead of the wall clock.  That
+// replays the parser callbacks and scene updates deterministically; see
+// sdlmain.c --replay.  When the trace runs out FluidNC falls silent, so the
+// replay then fast-forwards the clock and checks that the ping and
+// disconnect ladder declares the link lost within TRACE_REPLAY_SILENCE_MS.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef FNC_TRACE_RING
+#    define FNC_TRACE_RING 16384
+#endif
+
+#ifndef FNC_TRACE_FILE
+#    define FNC_TRACE_FILE "/fnc_trace.bin"
+#endif
+
+#ifndef TRACE_REPLAY_SILENCE_MS
+#    define TRACE_REPLAY_SILENCE_MS 10000
+#endif
+
+#ifdef FNC_TRACE
+void trace_rx(uint8_t c);
+void trace_tx(uint8_t c);
+void trace_enable(bool on);
+
+// Write the ring to a file; returns false on failure
+bool trace_save(const char* path);
+
+#    ifndef ARDUINO
+// Replay the trace file; returns the process exit status
+int trace_replay(const char* path);
+
+bool   trace_replaying();
+size_t trace_replay_slice(const uint8_t** data);
+void   trace_replay_release(size_t n);
+void   trace_replay_putchar(uint8_t c);
+#    endif
+#else
+inline void trace_rx(uint8_t c) {}
+inline void trace_tx(uint8_t c) {}
+#endif
+
+#if !defined(FNC_TRACE) || defined(ARDUINO)
+inline bool   trace_replaying() { return false; }
+inline size_t trace_replay_slice(const uint8_t** data) { return 0; }
+inline void   trace_replay_release(size_t n) {}
+inline void   trace_replay_putchar(uint8_t c) {}
+#endif
@@ -0,0 +1,178 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "GlyphAtlas.h"
+#include <algorithm>
+#include <cstring>
+
+static const int first_glyph = ' ';
+static const int last_glyph  = '~';
+static const int n_glyphs    = last_glyph - first_glyph + 1;
+static const int n_fonts     = MEDIUM_MONO + 1;
+
+// Cells are padded on both sides so glyphs that overhang their advance
+// width are not cut off.
+static const int pad = 2;
+
+struct Atlas {
+    LGFX_Sprite* sprite;
+    bool         tried;                 // Allocation was attempted
+    int          height;                // Font height; also the strip height
+    uint16_t     cell_x[n_glyphs + 1];  // Left edge of each cell in the strip
+    uint8_t      advance[n_glyphs];     // Cursor step after each glyph
+    uint8_t      extent[n_glyphs];      // textWidth() of the glyph alone
+};
+
+static Atlas atlases[n_fonts];
+static bool  enabled    = true;
+static int   atlas_used = 0;
+
+void glyph_atlas_enable(bool on) {
+    enabled = on;
+}
+
+int glyph_atlas_bytes() {
+    return atlas_used;
+}
+
+static LGFX_Sprite* get_atlas(fontnum_t fontnum) {
+    Atlas& a = atlases[fontnum];
+    if (a.sprite || a.tried) {
+        return a.sprite;
+    }
+    a.tried = true;
+
+    // The cursor steps by the glyph's own advance, as drawString() does,
+    // but a cell has to hold the whole glyph, which textWidth() measures
+    // with the canvas, which already has this font selected
+    char txt[2] = { '\0', '\0' };
+    int  width  = 0;
+    for (int i = 0; i < n_glyphs; i++) {
+        txt[0]       = first_glyph + i;
+        a.advance[i] = glyph_advance(fontnum, txt[0]);
+        a.extent[i]  = canvas.textWidth(txt);
+        a.cell_x[i]  = width;
+        width += a.extent[i] + 2 * pad;
+    }
+    a.cell_x[n_glyphs] = width;
+    a.height           = canvas.fontHeight();
+
+    int bytes = ((width + 7) / 8) * a.height;
+    if (atlas_used + bytes > GLYPH_ATLAS_BUDGET) {
+        return nullptr;
+    }
+
+    LGFX_Sprite* sprite = new LGFX_Sprite(&canvas);
+    sprite->setColorDepth(1);
+    if (!sprite->createSprite(width, a.height)) {
+        delete sprite;
+        return nullptr;
+    }
+    sprite->createPalette();
+    sprite->fillSprite(0);
+    sprite->setFont(font[fontnum]);
+    sprite->setTextDatum(top_left);
+    sprite->setTextColor(1);
+    for (int i = 1; i < n_glyphs; i++) {  // Skip the space
+        txt[0] = first_glyph + i;
+        sprite->drawString(txt, a.cell_x[i] + pad, 0);
+    }
+    atlas_used += bytes;
+    a.sprite = sprite;
+    return sprite;
+}
+
+bool glyph_atlas_text(const char* msg, int x, int y, int color, fontnum_t fontnum, int datum) {
+    // Baseline datums need the font's ascent, which the atlas does not keep
+    if (!enabled || (datum & 0x10)) {
+        return false;
+    }
+    int width = 0;
+    for (const char* p = msg; *p; ++p) {
+        if (*p < first_glyph || *p > last_glyph) {
+            return false;
+        }
+    }
+    Atlas& a = atlases[fontnum];
+    if (!get_atlas(fontnum)) {
+        return false;
+    }
+    // Measured like textWidth(): the last glyph counts its whole extent
+    for (const char* p = msg; *p; ++p) {
+        int i = *p - first_glyph;
+        width += p[1] ? a.advance[i] : a.extent[i];
+    }
+
+    // Same placement rules as drawString()
+    switch (datum & 3) {
+        case 1:
+            x -= width / 2;
+            break;
+        case 2:
+            x -= width;
+            break;
+    }
+    switch (datum & 0x0c) {
+        case 4:
+            y -= a.height / 2;
+            break;
+        case 8:
+            y -= a.height;
+            break;
+    }
+
+    // Each glyph is clipped to its cell, within whatever clip rectangle the
+    // caller has set, which is put back afterwards
+    int32_t clip_x, clip_y, clip_w, clip_h;
+    canvas.getClipRect(&clip_x, &clip_y, &clip_w, &clip_h);
+
+    a.sprite->setPaletteColor(1, color);
+    for (const char* p = msg; *p; ++p) {
+        int i = *p - first_glyph;
+        if (i) {
+            int cell_x = a.cell_x[i];
+            int x0     = std::max<int>(x - pad, clip_x);
+            int y0     = std::max<int>(y, clip_y);
+            int x1     = std::min<int>(x - pad + a.cell_x[i + 1] - cell_x, clip_x + clip_w);
+            int y1     = std::min<int>(y + a.height, clip_y + clip_h);
+            if (x0 < x1 && y0 < y1) {
+                canvas.setClipRect(x0, y0, x1 - x0, y1 - y0);
+                a.sprite->pushSprite(x - pad - cell_x, y, 0);
+            }
+        }
+        x += a.advance[i];
+    }
+    canvas.setClipRect(clip_x, clip_y, clip_w, clip_h);
+    return true;
+}
+
+#ifdef GLYPH_ATLAS_BENCH
+void glyph_atlas_benchmark() {
+    static const char* sample     = "X-123.456 Feed:100% Spd:12000";
+    const int          iterations = 500;
+    int                n_chars    = strlen(sample);
+
+    for (int f = 0; f < n_fonts; f++) {
+        uint32_t elapsed[2];
+        for (int pass = 0; pass < 2; pass++) {
+            glyph_atlas_enable(pass == 1);
+            text(sample, 120, 120, WHITE, (fontnum_t)f);  // Builds the atlas outside the timing
+            uint32_t start = millis();
+            for (int i = 0; i < iterations; i++) {
+                text(sample, 120, 120, WHITE, (fontnum_t)f);
+            }
+            elapsed[pass] = millis() - start;
+            if (elapsed[pass] == 0) {
+                elapsed[pass] = 1;
+            }
+        }
+        uint32_t glyphs = (uint32_t)iterations * n_chars;
+        dbg_printf("Font %d: %u glyphs/s GFXfont, %u glyphs/s atlas%s\n",
+                   f,
+                   glyphs * 1000 / elapsed[0],
+                   glyphs * 1000 / elapsed[1],
+                   atlases[f].sprite ? "" : " (over budget)");
+    }
+    dbg_printf("Glyph atlases use %d bytes\n", glyph_atlas_bytes());
+    glyph_atlas_enable(true);
+}
+#endif
@@ -0,0 +1,34 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Pre-rasterized glyph atlases for the fonts in Text.cpp.
+//
+// GFXfont glyphs are decoded bit by bit on every drawString.  The first time
+// a font is used, its printable ASCII glyphs are rendered once into a 1-bit
+// strip, and text() then blits each character from the strip, colored
+// through the strip's palette.  Fonts whose strip would exceed the memory
+// budget keep using the GFXfont path.
+
+#pragma once
+
+#include "Text.h"
+
+// Total bytes that all atlases together may use.  Override with -D.
+#ifndef GLYPH_ATLAS_BUDGET
+#    define GLYPH_ATLAS_BUDGET 20480
+#endif
+
+// Draw msg from the atlas for fontnum.  Returns false, having drawn
+// nothing, if the string cannot be drawn that way; the caller must then
+// use the GFXfont path.  The canvas font must already be font[fontnum].
+bool glyph_atlas_text(const char* msg, int x, int y, int color, fontnum_t fontnum, int datum);
+
+// Turn the fast path on or off, e.g. for comparisons
+void glyph_atlas_enable(bool on);
+
+// Bytes currently held by atlases
+int glyph_atlas_bytes();
+
+#ifdef GLYPH_ATLAS_BENCH
+// Print text() throughput for each font with and without the atlas
+void glyph_atlas_benchmark();
+#endif
@@ -13,6 +13,8 @@
 #include "Drawing.h"
 #include "NVS.h"
 #include "Scene.h"
+#include "StaticLayer.h"
+#include "AsyncPush.h"
 
 #include <driver/uart.h>
 #include "hal/uart_hal.h"
@@ -358,8 +360,11 @@ int32_t layout_num = 0;
 Point sprite_offset;
 void  set_layout(int n) {
      layout = &layouts[n];
+     display_wait_idle();
      display.setRotation(layout->rotation());
      sprite_offset = layout->spritePosition;
+     invalidate_display();  // The whole canvas moves to a new place on the panel
+     static_layers_invalidate_all();
 }
 
 nvs_handle_t hw_nvs;
@@ -516,6 +521,7 @@ int last_locked = -1;
 
 void redrawButtons() {
     bool show = !current_scene || current_scene->showButtons();
+    display_wait_idle();
     display.startWrite();
     for (int i = 0; i < n_buttons; i++) {
         Point position = layout->buttonsXY + layout->buttonOffset(i);
@@ -534,6 +540,7 @@ void redrawButtons() {
 extern const char* git_info;
 
 void show_logo() {
+    display_wait_idle();
     display.clear();
     display.drawPngFile(
         LittleFS, "/fluid_dial.png", sprite_offset.x, sprite_offset.y, sprite_wh, sprite_wh, 0, 0, 0.0f, 0.0f, datum_t::middle_center);
@@ -565,6 +572,9 @@ void next_layout(int delta) {
 void system_background() {
     drawBackground(BLACK);
 }
+void system_background(int x, int y, int width, int height) {
+    canvas.fillRect(x, y, width, height, BLACK);
+}
 
 
 bool switch_button_touched(bool& pressed, int& button) {
@@ -87,7 +87,10 @@ void base_display() {
 void next_layout(int delta) {}
 
 void system_background() {
-    canvas.fillSprite(TFT_BLACK);
+    drawBackground(BLACK);
+}
+void system_background(int x, int y, int width, int height) {
+    canvas.fillRect(x, y, width, height, BLACK);
 }
 
 bool switch_button_touched(bool& pressed, int& button) {
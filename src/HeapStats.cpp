@@ -0,0 +1,124 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "HeapStats.h"
+#include "Metrics.h"
+#include <atomic>
+#ifdef ARDUINO
+#    include "BootLog.h"
+#    include "GrblParserC.h"  // milliseconds()
+#    include "System.h"  // dbg_printf()
+#    include <esp_heap_caps.h>
+#else
+#    include <cstdlib>
+#    include <new>
+#endif
+
+// Plain arrays rather than Counter objects because operator new counts
+// into them before static constructors have run.  Atomic because on host
+// builds every thread allocates through operator new; relaxed is enough
+// for counts that are only read for display.
+static std::atomic<uint32_t> tag_count[HEAP_N_TAGS];
+static std::atomic<uint32_t> tag_bytes[HEAP_N_TAGS];
+
+template <int T>
+static int32_t read_count() {
+    return tag_count[T].load(std::memory_order_relaxed);
+}
+template <int T>
+static int32_t read_bytes() {
+    return tag_bytes[T].load(std::memory_order_relaxed);
+}
+
+static Gauge other_count("heap.other.count", read_count<HEAP_OTHER>);
+static Gauge other_bytes("heap.other.bytes", read_bytes<HEAP_OTHER>);
+static Gauge png_count("heap.png.count", read_count<HEAP_PNG>);
+static Gauge png_bytes("heap.png.bytes", read_bytes<HEAP_PNG>);
+static Gauge json_count("heap.json.count", read_count<HEAP_JSON>);
+static Gauge json_bytes("heap.json.bytes", read_bytes<HEAP_JSON>);
+static Gauge menu_count("heap.menu.count", read_count<HEAP_MENU>);
+static Gauge menu_bytes("heap.menu.bytes", read_bytes<HEAP_MENU>);
+static Gauge scene_count("heap.scene.count", read_count<HEAP_SCENE>);
+static Gauge scene_bytes("heap.scene.bytes", read_bytes<HEAP_SCENE>);
+
+#ifdef ARDUINO
+static HeapTag current_tag = HEAP_OTHER;
+
+static Gauge   heap_free("heap.free");
+static Gauge   heap_largest("heap.largest_block");
+static Gauge   heap_min_free("heap.min_free");
+static Counter heap_warnings("heap.warnings");
+
+HeapScope::HeapScope(HeapTag tag) : _prev(current_tag), _free_at_entry(heap_caps_get_free_size(MALLOC_CAP_8BIT)) {
+    current_tag = tag;
+}
+
+HeapScope::~HeapScope() {
+    size_t now = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    tag_count[current_tag].fetch_add(1, std::memory_order_relaxed);
+    if (now < _free_at_entry) {
+        tag_bytes[current_tag].fetch_add(_free_at_entry - now, std::memory_order_relaxed);
+    }
+    current_tag = _prev;
+}
+
+void heap_poll() {
+    static uint32_t last_ms = 0;
+    static bool     warned  = false;
+
+    uint32_t now = milliseconds();
+    if ((now - last_ms) < HEAP_SAMPLE_MS) {
+        return;
+    }
+    last_ms = now;
+
+    size_t free_now = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    size_t largest  = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    heap_free.set(free_now);
+    heap_largest.set(largest);
+    heap_min_free.set(heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+
+    // Re-arm only after a margin of recovery so a heap hovering at the
+    // threshold does not fill the boot log
+    if (!warned && largest < HEAP_WARN_LARGEST) {
+        warned = true;
+        ++heap_warnings;
+        bootlog_printf("Heap low: free %u largest %u", (unsigned)free_now, (unsigned)largest);
+        dbg_printf("Heap low: free %u largest %u\n", (unsigned)free_now, (unsigned)largest);
+    } else if (warned && largest > HEAP_WARN_LARGEST * 5 / 4) {
+        warned = false;
+    }
+}
+#else
+// Per thread, so allocations from the SDL and network threads are not
+// charged to whatever scope the main loop is in
+static thread_local HeapTag  current_tag = HEAP_OTHER;
+static thread_local uint32_t allocations = 0;
+
+HeapScope::HeapScope(HeapTag tag) : _prev(current_tag) {
+    current_tag = tag;
+}
+
+HeapScope::~HeapScope() {
+    current_tag = _prev;
+}
+
+uint32_t heap_allocations() {
+    return allocations;
+}
+
+// The other forms of new and delete in the C++ runtime forward to these
+void* operator new(std::size_t size) {
+    ++allocations;
+    tag_count[current_tag].fetch_add(1, std::memory_order_relaxed);
+    tag_bytes[current_tag].fetch_add(size, std::memory_order_relaxed);
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+#endif
@@ -0,0 +1,67 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Heap telemetry.
+//
+// On the dial, heap_poll() samples the free heap, the largest free block
+// and the lowest free heap since boot every HEAP_SAMPLE_MS and publishes
+// them as the heap.free, heap.largest_block and heap.min_free metrics.
+// Fragmentation shows up as a largest block well below the free heap;
+// when the largest block drops under HEAP_WARN_LARGEST a warning goes to
+// the boot log (once, until it recovers), since that is the point where
+// mDNS and TLS start failing to allocate.
+//
+// Allocations are also attributed to the subsystem that makes them.  Code
+// that allocates on behalf of a subsystem opens a scope:
+//
+//   HeapScope heap_scope(HEAP_PNG);
+//
+// and each tag has a heap.<tag>.count and heap.<tag>.bytes metric.  Host
+// builds replace operator new, so there they are the number and size of
+// the allocations made inside the scope.  The ESP32 heap has no allocation
+// hook, so on the dial the count is how often the scope ran and the bytes
+// are the heap it left allocated, which is what fragments the heap over
+// time.  Allocations outside any scope count as "other" on host builds.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef HEAP_SAMPLE_MS
+#    define HEAP_SAMPLE_MS 1000
+#endif
+
+// Largest free block, in bytes, below which a low-heap warning is logged
+#ifndef HEAP_WARN_LARGEST
+#    define HEAP_WARN_LARGEST 32768
+#endif
+
+enum HeapTag : uint8_t {
+    HEAP_OTHER,
+    HEAP_PNG,    // PNG decodes
+    HEAP_JSON,   // Streaming JSON parser and its listeners
+    HEAP_MENU,   // Menu items built from file and macro lists
+    HEAP_SCENE,  // Scene redraws, mostly std::string labels and legends
+    HEAP_N_TAGS,
+};
+
+class HeapScope {
+public:
+    explicit HeapScope(HeapTag tag);
+    ~HeapScope();
+
+private:
+    HeapTag _prev;
+#ifdef ARDUINO
+    size_t _free_at_entry;
+#endif
+};
+
+#ifdef ARDUINO
+void heap_poll();
+#else
+inline void heap_poll() {}
+
+// Allocations made through operator new by the calling thread so far
+uint32_t heap_allocations();
+#endif
@@ -0,0 +1,53 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Histogram.h"
+
+void Histogram::add(uint32_t us) {
+    int      i = 0;
+    uint32_t v = us;
+    while (v && i < N_BUCKETS - 1) {
+        v >>= 1;
+        ++i;
+    }
+    ++_buckets[i];
+    ++_total;
+    if (++_count >= _window) {
+        _count = 0;
+        for (auto& b : _buckets) {
+            b >>= 1;
+            _count += b;
+        }
+    }
+    if (us > _max) {
+        _max = us;
+    }
+}
+
+void Histogram::reset() {
+    for (auto& b : _buckets) {
+        b = 0;
+    }
+    _count = 0;
+    _total = 0;
+    _max   = 0;
+}
+
+uint32_t Histogram::bucket_limit(int i) {
+    return i >= N_BUCKETS - 1 ? UINT32_MAX : (1u << i) - 1;
+}
+
+uint32_t Histogram::percentile(int pct) const {
+    if (!_count) {
+        return 0;
+    }
+    uint32_t target = ((uint64_t)_count * pct + 99) / 100;
+    uint32_t seen   = 0;
+    for (int i = 0; i < N_BUCKETS; i++) {
+        seen += _buckets[i];
+        if (seen >= target && _buckets[i]) {
+            uint32_t limit = bucket_limit(i);
+            return limit < _max ? limit : _max;
+        }
+    }
+    return _max;
+}
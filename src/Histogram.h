@@ -0,0 +1,44 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Rolling log2 histogram of microsecond durations.
+//
+// Bucket 0 counts samples under 1 us and bucket i counts samples from
+// 2^(i-1) up to 2^i - 1 us; the last bucket takes everything longer.
+// Adding a sample is a few instructions and the whole thing is under 100
+// bytes, so one can sit on any hot path.  When the sample count reaches
+// the window every bucket is halved, so the histogram keeps reflecting
+// recent behavior rather than the whole uptime.  Percentiles are reported
+// as the upper bound of the bucket they fall in; the maximum since reset()
+// is exact.
+
+#pragma once
+
+#include <cstdint>
+
+class Histogram {
+public:
+    static const int N_BUCKETS = 18;  // Up to 65 ms, and longer
+
+    explicit Histogram(uint32_t window = 4096) : _window(window) {}
+
+    void add(uint32_t us);
+    void reset();
+
+    uint32_t count() const { return _count; }
+    uint32_t total() const { return _total; }  // Samples since reset, not decayed
+    uint32_t max() const { return _max; }
+    uint32_t bucket(int i) const { return _buckets[i]; }
+
+    // Upper bound in us of the bucket holding the given percentile, 0-100
+    uint32_t percentile(int pct) const;
+
+    // Upper bound in us of bucket i
+    static uint32_t bucket_limit(int i);
+
+private:
+    uint32_t _buckets[N_BUCKETS] = {};
+    uint32_t _count              = 0;
+    uint32_t _total              = 0;
+    uint32_t _max                = 0;
+    uint32_t _window;
+};
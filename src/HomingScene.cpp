@@ -3,6 +3,7 @@
 
 #include "Scene.h"
 #include "ConfigItem.h"
+#include "Widget.h"
 
 extern Scene statusScene;
 
@@ -60,6 +61,14 @@ private:
 
     bool _allows[HOMING_N_AXIS];
 
+    WidgetList   _widgets;
+    TitleWidget  _title;
+    StatusWidget _status;
+    DROWidget    _dro[HOMING_N_AXIS] = { { 16, 68, 210, 32 }, { 16, 101, 210, 32 }, { 16, 134, 210, 32 } };
+    LegendWidget _legends;
+    bool         _redraw_all  = true;
+    bool         _showing_dro = false;  // Which body layout is on screen
+
 public:
     HomingScene() : Scene("Home", 4) {}
 
@@ -73,6 +82,14 @@ public:
         if (!have_homing_info()) {
             schedule_action(detect_homing_info);
         }
+        _widgets.clear();
+        _widgets.add(&_title);
+        _widgets.add(&_status);
+        for (auto& dro : _dro) {
+            _widgets.add(&dro);
+        }
+        _widgets.add(&_legends);
+        _redraw_all = true;
     }
 
     void onStateChange(state_t old_state) override {
@@ -123,48 +140,33 @@ public:
         increment_axis_to_home();
         reDisplay();
     }
-    void onDROChange() { reDisplay(); }  // also covers any status change
+    void     onDROChange(uint32_t changes) { request_redisplay(); }
+    uint32_t modelInterest() override { return MODEL_STATE | MODEL_AXES | MODEL_LIMITS | MODEL_PINS | MODEL_MODES; }
+    int      reportInterval() override { return state == Homing ? REPORT_FAST_MS : REPORT_NORMAL_MS; }
 
     void reDisplay() {
-        background();
-        drawMenuTitle(current_scene->name());
-        drawStatus();
+        // The body switches between the homing DRO and a warning, so
+        // start over from the background when the layout changes.
+        bool show_dro = state == Idle || state == Homing || state == Alarm;
+        bool redrawn  = _redraw_all || show_dro != _showing_dro;
+        if (redrawn) {
+            background();
+            _widgets.invalidate();
+            _redraw_all  = false;
+            _showing_dro = show_dro;
+        }
+        _title.set(name());
+        _status.update();
 
         const char* redLabel    = "";
         std::string grnLabel    = "";
         const char* orangeLabel = "";
-        std::string green       = "Home ";
-
-        if (false && state == Homing) {
-            DRO dro(16, 68, 210, 32);
-            for (size_t axis = 0; axis < HOMING_N_AXIS; axis++) {
-                dro.draw(axis, -1, true);
-            }
 
-        } else if (state == Idle || state == Homing || state == Alarm) {
-            DRO dro(16, 68, 210, 32);
+        if (show_dro) {
             for (int axis = 0; axis < HOMING_N_AXIS; ++axis) {
-                dro.drawHoming(axis, is_homing(axis), is_homed(axis));
+                _dro[axis].setHoming(axis, is_homing(axis), is_homed(axis));
             }
 
-#if 0
-            int x      = 50;
-            int y      = 65;
-            int width  = display.width() - (x * 2);
-            int height = 32;
-
-            Stripe button(x, y, width, height, SMALL);
-            button.draw("Home All", _axis_to_home == -1);
-            y = button.y();  // LEDs start with the Home X button
-            button.draw("Home X", _axis_to_home == 0);
-            button.draw("Home Y", _axis_to_home == 1);
-            button.draw("Home Z", _axis_to_home == 2);
-            LED led(x - 16, y + height / 2, 10, button.gap());
-            led.draw(myLimitSwitches[0]);
-            led.draw(myLimitSwitches[1]);
-            led.draw(myLimitSwitches[2]);
-#endif
-
             if (state == Homing) {
                 redLabel = "E-Stop";
             } else {
@@ -189,8 +191,10 @@ public:
                 }
             }
         } else {
-            centered_text("Invalid State", 105, WHITE, MEDIUM);
-            centered_text("For Homing", 145, WHITE, MEDIUM);
+            if (redrawn) {
+                centered_text("Invalid State", 105, WHITE, MEDIUM);
+                centered_text("For Homing", 145, WHITE, MEDIUM);
+            }
             redLabel = "E-Stop";
             if (state == Cycle) {
                 grnLabel = "Hold";
@@ -198,7 +202,7 @@ public:
                 grnLabel = "Resume";
             }
         }
-        drawButtonLegends(redLabel, grnLabel.c_str(), orangeLabel[0] ? orangeLabel : "Back");
+        _legends.set(redLabel, grnLabel.c_str(), orangeLabel[0] ? orangeLabel : "Back");
 
         refreshDisplay();
     }
@@ -0,0 +1,158 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "JogLatency.h"
+
+#ifdef JOG_LATENCY
+#    include "System.h"
+#    include "FluidNCModel.h"
+#    include <cstring>
+#    if defined(USE_WIFI) && defined(ARDUINO)
+#        include "WiFiConnection.h"
+#    endif
+
+static const int      MAX_PENDING    = 8;        // More than JOG_MAX_INFLIGHT
+static const uint32_t DRO_TIMEOUT_US = 2000000;  // Give up on a jog that never showed motion
+
+struct PendingJog {
+    uint32_t tick_us;
+    uint32_t send_us;
+};
+
+static const char* transport_names[N_JOG_TRANSPORTS] = { "UART", "Telnet", "ESP-NOW" };
+static const char* stage_names[N_JOG_STAGES]         = { "tick-send", "send-ok", "tick-ok", "tick-dro" };
+
+static Histogram hist[N_JOG_TRANSPORTS][N_JOG_STAGES];
+
+static bool       tick_pending = false;
+static uint32_t   tick_us      = 0;
+static PendingJog pending[MAX_PENDING];
+static int        pending_head  = 0;
+static int        pending_count = 0;
+
+// The jog being timed to the DRO, and the position shown when it was sent
+static bool     awaiting_motion = false;
+static uint32_t motion_tick_us  = 0;
+static pos_t    start_axes[6];
+
+jog_transport_t jog_latency_transport() {
+#    if defined(USE_WIFI) && defined(ARDUINO)
+    switch (wifi_get_transport()) {
+        case TransportMode::WIFI:
+            return JOG_TELNET;
+        case TransportMode::ESPNOW:
+            return JOG_ESPNOW;
+        default:
+            break;
+    }
+#    endif
+    return JOG_UART;  // Host builds talk to a serial port or a replayed trace
+}
+
+static void record(int stage, uint32_t us) {
+    hist[jog_latency_transport()][stage].add(us);
+}
+
+void jog_latency_tick() {
+    if (!tick_pending) {
+        tick_pending = true;
+        tick_us      = microseconds();
+    }
+}
+
+void jog_latency_sent() {
+    uint32_t now = microseconds();
+    uint32_t t   = now;  // Button jogs have no tick
+    if (tick_pending) {
+        t            = tick_us;
+        tick_pending = false;
+        record(JOG_TICK_TO_SEND, now - t);
+    }
+
+    if (pending_count == MAX_PENDING) {  // Lost acks; forget the oldest
+        pending_head = (pending_head + 1) % MAX_PENDING;
+        --pending_count;
+    }
+    pending[(pending_head + pending_count++) % MAX_PENDING] = { t, now };
+
+    if (!awaiting_motion && state != Jog) {
+        awaiting_motion = true;
+        motion_tick_us  = t;
+        memcpy(start_axes, myAxes, sizeof(start_axes));
+    }
+}
+
+void jog_latency_ok() {
+    if (!pending_count) {
+        return;  // Not a jog line
+    }
+    PendingJog& p   = pending[pending_head];
+    uint32_t    now = microseconds();
+    pending_head    = (pending_head + 1) % MAX_PENDING;
+    --pending_count;
+    record(JOG_SEND_TO_OK, now - p.send_us);
+    record(JOG_TICK_TO_OK, now - p.tick_us);
+}
+
+void jog_latency_cancel() {
+    pending_count = 0;
+    tick_pending  = false;
+}
+
+void jog_latency_report() {
+    if (!awaiting_motion) {
+        return;
+    }
+    uint32_t elapsed = microseconds() - motion_tick_us;
+    if (elapsed > DRO_TIMEOUT_US) {
+        awaiting_motion = false;
+        return;
+    }
+    for (int axis = 0; axis < n_axes; axis++) {
+        if (myAxes[axis] != start_axes[axis]) {
+            awaiting_motion = false;
+            record(JOG_TICK_TO_DRO, elapsed);
+            return;
+        }
+    }
+}
+
+const char* jog_transport_name(int transport) {
+    return transport_names[transport];
+}
+const char* jog_stage_name(int stage) {
+    return stage_names[stage];
+}
+const Histogram& jog_latency_histogram(int transport, int stage) {
+    return hist[transport][stage];
+}
+
+void jog_latency_export() {
+    dbg_printf("transport,stage,count,p50_us,p90_us,p99_us,max_us\n");
+    for (int t = 0; t < N_JOG_TRANSPORTS; t++) {
+        for (int s = 0; s < N_JOG_STAGES; s++) {
+            const Histogram& h = hist[t][s];
+            if (h.total()) {
+                dbg_printf("%s,%s,%u,%u,%u,%u,%u\n",
+                           transport_names[t],
+                           stage_names[s],
+                           h.total(),
+                           h.percentile(50),
+                           h.percentile(90),
+                           h.percentile(99),
+                           h.max());
+            }
+        }
+    }
+    dbg_printf("transport,stage,bucket_max_us,count\n");
+    for (int t = 0; t < N_JOG_TRANSPORTS; t++) {
+        for (int s = 0; s < N_JOG_STAGES; s++) {
+            const Histogram& h = hist[t][s];
+            for (int i = 0; i < Histogram::N_BUCKETS; i++) {
+                if (h.bucket(i)) {
+                    dbg_printf("%s,%s,%u,%u\n", transport_names[t], stage_names[s], Histogram::bucket_limit(i), h.bucket(i));
+                }
+            }
+        }
+    }
+}
+#endif
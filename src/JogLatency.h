@@ -0,0 +1,65 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// End-to-end jog latency measurement.
+//
+// Built with -DJOG_LATENCY.  Follows a dial jog through the pendant and
+// FluidNC, timestamping the milestones on the microseconds() clock:
+//
+//   tick   the first encoder delta that is not yet part of a sent jog
+//   send   the $J= line that carries it leaves for FluidNC
+//   ok     FluidNC acknowledges that line
+//   DRO    the first status report whose position differs from the one
+//          shown when the jog was sent
+//
+// Sent jogs wait in a small FIFO for their "ok"; a JogCancel empties it.
+// FluidNCModel matches answers to the lines they answer, so only the
+// answers to jog lines reach this FIFO.
+// Only a jog that starts from rest is timed to the DRO, because once the
+// machine is moving a report cannot tell which jog moved it; that is also
+// the delay the operator notices most.
+//
+// The intervals tick->send, send->ok, tick->ok and tick->DRO are kept in
+// Histograms, one set per transport, so MPG_INTERVAL_MS and QUEUE_CAP_MS can
+// be tuned against data.  The About scene shows the current transport's
+// medians.  CTRL-E on the debug port exports all of them as CSV.
+
+#pragma once
+
+#include "Histogram.h"
+
+enum jog_stage_t {
+    JOG_TICK_TO_SEND,
+    JOG_SEND_TO_OK,
+    JOG_TICK_TO_OK,
+    JOG_TICK_TO_DRO,
+    N_JOG_STAGES,
+};
+
+enum jog_transport_t {
+    JOG_UART,
+    JOG_TELNET,
+    JOG_ESPNOW,
+    N_JOG_TRANSPORTS,
+};
+
+#ifdef JOG_LATENCY
+void jog_latency_tick();    // Encoder delta accumulated for a later jog
+void jog_latency_sent();    // $J= line sent; call just before sending it
+void jog_latency_ok();      // A jog line was answered, "ok" or error
+void jog_latency_cancel();  // JogCancel: outstanding jogs will not be acknowledged
+void jog_latency_report();  // Status report parsed
+
+jog_transport_t  jog_latency_transport();
+const char*      jog_transport_name(int transport);
+const char*      jog_stage_name(int stage);
+const Histogram& jog_latency_histogram(int transport, int stage);
+
+void jog_latency_export();
+#else
+inline void jog_latency_tick() {}
+inline void jog_latency_sent() {}
+inline void jog_latency_ok() {}
+inline void jog_latency_cancel() {}
+inline void jog_latency_report() {}
+inline void jog_latency_export() {}
+#endif
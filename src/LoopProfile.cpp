@@ -0,0 +1,128 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "LoopProfile.h"
+
+static const char* phase_names[N_LOOP_PHASES] = { "transport", "fnc_poll", "dispatch", "redisplay" };
+
+const char* loop_phase_name(int phase) {
+    return phase_names[phase];
+}
+
+#ifdef LOOP_PROFILE
+#    include "System.h"
+#    include "BootLog.h"
+#    include "GrblParserC.h"  // milliseconds()
+#    ifdef ARDUINO
+#        include <Esp.h>  // ESP.getCycleCount()
+#    endif
+
+#    ifdef ARDUINO
+static inline uint32_t cycles() {
+    return ESP.getCycleCount();
+}
+static uint32_t cycles_per_us() {
+    return ESP.getCpuFreqMHz();
+}
+#    else
+static inline uint32_t cycles() {
+    return microseconds();
+}
+static uint32_t cycles_per_us() {
+    return 1;
+}
+#    endif
+
+static Histogram phase_hist[N_LOOP_PHASES];
+static Histogram iteration_hist;
+
+static uint32_t per_us          = 0;
+static uint32_t iteration_start = 0;
+static uint32_t last_mark       = 0;
+static uint32_t phase_us[N_LOOP_PHASES];
+static uint32_t stalls          = 0;
+static uint32_t stalls_unlogged = 0;
+static uint32_t last_stall_log  = 0;
+
+void loop_profile_begin() {
+    if (!per_us) {
+        per_us = cycles_per_us();
+    }
+    for (auto& us : phase_us) {
+        us = 0;
+    }
+    iteration_start = last_mark = cycles();
+    alloc_profile_begin();
+}
+
+void loop_profile_mark(loop_phase_t phase) {
+    uint32_t now = cycles();
+    phase_us[phase] += (now - last_mark) / per_us;
+    last_mark = now;
+    alloc_profile_mark(phase);
+}
+
+void loop_profile_end() {
+    alloc_profile_end();
+    for (int i = 0; i < N_LOOP_PHASES; i++) {
+        phase_hist[i].add(phase_us[i]);
+    }
+    uint32_t us = (cycles() - iteration_start) / per_us;
+    iteration_hist.add(us);
+
+    if (us < LOOP_STALL_US) {
+        return;
+    }
+    ++stalls;
+    uint32_t now = milliseconds();
+    if (last_stall_log && now - last_stall_log < LOOP_STALL_LOG_MS) {
+        ++stalls_unlogged;
+        return;
+    }
+    last_stall_log = now;
+
+    int worst = 0;
+    for (int i = 1; i < N_LOOP_PHASES; i++) {
+        if (phase_us[i] > phase_us[worst]) {
+            worst = i;
+        }
+    }
+    bootlog_printf("stall %ums %s %ums +%u", us / 1000, phase_names[worst], phase_us[worst] / 1000, stalls_unlogged);
+    stalls_unlogged = 0;
+}
+
+const Histogram& loop_phase_histogram(int phase) {
+    return phase_hist[phase];
+}
+const Histogram& loop_iteration_histogram() {
+    return iteration_hist;
+}
+uint32_t loop_stalls() {
+    return stalls;
+}
+
+static void dump_histogram(const char* name, const Histogram& h) {
+    dbg_printf("%-10s n %8u  p50 %6u  p90 %6u  p99 %6u  max %6u us\n",
+               name,
+               h.total(),
+               h.percentile(50),
+               h.percentile(90),
+               h.percentile(99),
+               h.max());
+    for (int i = 0; i < Histogram::N_BUCKETS - 1; i++) {
+        if (h.bucket(i)) {
+            dbg_printf("  <= %6u us %6u\n", Histogram::bucket_limit(i), h.bucket(i));
+        }
+    }
+    if (h.bucket(Histogram::N_BUCKETS - 1)) {
+        dbg_printf("   > %6u us %6u\n", Histogram::bucket_limit(Histogram::N_BUCKETS - 2), h.bucket(Histogram::N_BUCKETS - 1));
+    }
+}
+
+void loop_profile_dump() {
+    dbg_printf("Loop profile, %u stalls over %u us\n", stalls, (unsigned)LOOP_STALL_US);
+    dump_histogram("loop", iteration_hist);
+    for (int i = 0; i < N_LOOP_PHASES; i++) {
+        dump_histogram(phase_names[i], phase_hist[i]);
+    }
+}
+#endif
@@ -0,0 +1,68 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Main loop phase profiler.
+//
+// Built with -DLOOP_PROFILE.  loop() brackets each of its phases - the
+// transport poll, the fnc_poll() drain, dispatch_events() and
+// service_redisplay() - with loop_profile_mark().  The time of each phase
+// is read from the CPU cycle counter (microseconds() on host builds) and
+// added to a rolling histogram for that phase, and the whole iteration to
+// another.
+//
+// An iteration longer than LOOP_STALL_US is a stall.  Stalls are counted,
+// and logged to the BootLog ring with the phase that took the longest, at
+// most once every LOOP_STALL_LOG_MS so a string of them cannot flush the
+// connection history out of the ring.
+//
+// The summary is shown on the About scene; loop_profile_dump() prints the
+// histograms, and CTRL-P on the debug port calls it.
+//
+// The marks also drive the allocation profiler (AllocProfile.h), which is
+// built separately.
+
+#pragma once
+
+#include "Histogram.h"
+#include "AllocProfile.h"
+#include <cstdint>
+
+#ifndef LOOP_STALL_US
+#    define LOOP_STALL_US 50000
+#endif
+
+#ifndef LOOP_STALL_LOG_MS
+#    define LOOP_STALL_LOG_MS 1000
+#endif
+
+enum loop_phase_t {
+    PHASE_TRANSPORT,  // wifi_poll() / espnow_poll()
+    PHASE_FNC_POLL,   // fnc_poll() drain
+    PHASE_DISPATCH,   // dispatch_events()
+    PHASE_REDISPLAY,  // service_redisplay()
+    N_LOOP_PHASES,
+};
+
+const char* loop_phase_name(int phase);
+
+#ifdef LOOP_PROFILE
+void loop_profile_begin();
+void loop_profile_mark(loop_phase_t phase);  // The time since the previous mark belongs to phase
+void loop_profile_end();
+
+const Histogram& loop_phase_histogram(int phase);
+const Histogram& loop_iteration_histogram();
+uint32_t         loop_stalls();
+
+void loop_profile_dump();
+#else
+inline void loop_profile_begin() {
+    alloc_profile_begin();
+}
+inline void loop_profile_mark(loop_phase_t phase) {
+    alloc_profile_mark(phase);
+}
+inline void loop_profile_end() {
+    alloc_profile_end();
+}
+inline void loop_profile_dump() {}
+#endif
@@ -40,6 +40,9 @@ void ImageButton::show(const Point& where) {
     }
     Point tp = where.to_display();
     _img_cache->pushSprite(tp.x-32, tp.y-32, 0);
+    mark_dirty(tp.x - 32, tp.y - 32, 64, 64);
+    hash_draw(OP_IMAGE_BUTTON, tp.x, tp.y);
+    hash_draw(_filename);
 }
 
 // v2, with alpha blending, at the cost of 3 sprite buffers, one for each state
@@ -143,14 +143,21 @@ public:
 class Menu : public Scene {
 private:
     void show_items() {
-        for (size_t i = 0; i < _items.size(); ++i) {
-            _items[i]->show(_positions[i]);
+        if (!_items_in_background) {
+            for (size_t i = 0; i < _items.size(); ++i) {
+                _items[i]->show(_positions[i]);
+            }
         }
         _items[_selected]->show(_positions[_selected]);
     }
 
     int _num_items = 0;
 
+protected:
+    // Set by menuBackground() when it has already drawn every item in its
+    // unhighlighted form, so that only the selected item needs drawing
+    bool _items_in_background = false;
+
 public:
     std::vector<Point> _positions;
     std::vector<Item*> _items;
@@ -176,6 +183,9 @@ public:
 
     void onEncoder(int delta) override { rotate(delta); }
 
+    // Menus only show the machine state, so a few Hz is plenty when idle
+    int redisplayInterval() override { return (state == Idle || state == Disconnected) ? 250 : 100; }
+
     void setPosition(int item_num, Point position) { _positions[item_num] = position; }
     void setItem(int item_num, Item* item) { _items[item_num] = item; }
     void addItem(Item* item, Point position = { 0, 0 }) {
@@ -0,0 +1,85 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Metrics.h"
+#include "System.h"  // dbg_printf()
+#include <cstdio>
+#include <cstring>
+
+// Constant-initialized, so metrics defined in other files can register from
+// their static constructors regardless of initialization order
+static Metric* registry[METRICS_MAX];
+static int     n_metrics = 0;
+static bool    sorted    = true;
+
+Metric::Metric(const char* name, Kind kind) : _name(name), _kind(kind) {
+    if (n_metrics < METRICS_MAX) {
+        registry[n_metrics++] = this;
+        sorted                = false;
+    }
+}
+
+static void sort_registry() {
+    for (int i = 1; i < n_metrics; i++) {
+        Metric* m = registry[i];
+        int     j = i;
+        for (; j > 0 && strcmp(registry[j - 1]->name(), m->name()) > 0; --j) {
+            registry[j] = registry[j - 1];
+        }
+        registry[j] = m;
+    }
+    sorted = true;
+}
+
+int metrics_count() {
+    return n_metrics;
+}
+
+Metric* metric_at(int i) {
+    if (!sorted) {
+        sort_registry();
+    }
+    return i >= 0 && i < n_metrics ? registry[i] : nullptr;
+}
+
+void Metric::format(char* buf, int len) const {
+    switch (_kind) {
+        case COUNTER:
+            snprintf(buf, len, "%u", static_cast<const Counter*>(this)->value());
+            break;
+        case GAUGE:
+            snprintf(buf, len, "%d", static_cast<const Gauge*>(this)->value());
+            break;
+        case HISTOGRAM: {
+            auto h = static_cast<const HistogramMetric*>(this);
+            snprintf(buf, len, "p50 %u p99 %u us", h->percentile(50), h->percentile(99));
+            break;
+        }
+    }
+}
+
+void metrics_dump() {
+    dbg_printf("# metrics %d\n", n_metrics);
+    for (int i = 0; i < n_metrics; i++) {
+        Metric* m = metric_at(i);
+        switch (m->kind()) {
+            case Metric::COUNTER:
+                dbg_printf("counter %s %u\n", m->name(), static_cast<Counter*>(m)->value());
+                break;
+            case Metric::GAUGE:
+                dbg_printf("gauge %s %d\n", m->name(), static_cast<Gauge*>(m)->value());
+                break;
+            case Metric::HISTOGRAM: {
+                auto h = static_cast<HistogramMetric*>(m);
+                dbg_printf("histogram %s n=%u p50=%u p90=%u p99=%u max=%u\n",
+                           m->name(),
+                           h->total(),
+                           h->percentile(50),
+                           h->percentile(90),
+                           h->percentile(99),
+                           h->max());
+                break;
+            }
+        }
+    }
+    dbg_printf("# end\n");
+}
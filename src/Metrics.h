@@ -0,0 +1,95 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Metrics registry.
+//
+// Subsystems define named metrics as static objects next to the code they
+// measure:
+//
+//   static Counter  rx_dropped("telnet.rx_dropped");
+//   static Gauge    heap_free("heap.free", [] { return (int32_t)free_heap(); });
+//   static HistogramMetric push_us("display.push_us");
+//
+// A Counter only counts up, a Gauge holds a value that is set or read from
+// a function when the metrics are listed, and a HistogramMetric is a
+// Histogram (log2 microsecond buckets).  Updating one is an inline add or
+// store on the object itself; the registry is only consulted when metrics
+// are listed, so an update costs a few cycles.
+//
+// Metrics register themselves from their constructors into a fixed table
+// of METRICS_MAX entries; a metric defined beyond that still works but is
+// not listed.  metrics_dump() prints every metric over the debug port
+// (CTRL-D) sorted by name, one per line:
+//
+//   # metrics <count>
+//   counter <name> <value>
+//   gauge <name> <value>
+//   histogram <name> n=<samples> p50=<us> p90=<us> p99=<us> max=<us>
+//   # end
+//
+// The Diagnostics scene shows the same list on the display.
+
+#pragma once
+
+#include "Histogram.h"
+#include <cstdint>
+
+#ifndef METRICS_MAX
+#    define METRICS_MAX 48
+#endif
+
+class Metric {
+public:
+    enum Kind : uint8_t { COUNTER, GAUGE, HISTOGRAM };
+
+    Metric(const char* name, Kind kind);
+
+    const char* name() const { return _name; }
+    Kind        kind() const { return _kind; }
+
+    // The value as text, e.g. "1234" or "p50 127 p99 2047 us"
+    void format(char* buf, int len) const;
+
+private:
+    const char* _name;
+    Kind        _kind;
+};
+
+class Counter : public Metric {
+public:
+    explicit Counter(const char* name) : Metric(name, COUNTER) {}
+
+    Counter& operator++() {
+        ++_value;
+        return *this;
+    }
+    Counter& operator+=(uint32_t n) {
+        _value += n;
+        return *this;
+    }
+    uint32_t value() const { return _value; }
+
+private:
+    uint32_t _value = 0;
+};
+
+class Gauge : public Metric {
+public:
+    explicit Gauge(const char* name, int32_t (*read)() = nullptr) : Metric(name, GAUGE), _read(read) {}
+
+    void    set(int32_t value) { _value = value; }
+    int32_t value() const { return _read ? _read() : _value; }
+
+private:
+    int32_t _value = 0;
+    int32_t (*_read)();
+};
+
+class HistogramMetric : public Metric, public Histogram {
+public:
+    explicit HistogramMetric(const char* name, uint32_t window = 4096) : Metric(name, HISTOGRAM), Histogram(window) {}
+};
+
+int     metrics_count();
+Metric* metric_at(int i);  // Sorted by name
+
+void metrics_dump();
@@ -5,6 +5,8 @@
 
 #include "Scene.h"
 #include "ConfirmScene.h"
+#include "StaticLayer.h"
+#include "JogLatency.h"
 #include "e4math.h"
 #include "System.h"  // dbg_printf()
 
@@ -131,6 +133,9 @@ private:
     static const uint32_t CANCEL_RESEND_MS = 80;
     static const uint32_t CANCEL_MIN_MS    = 250;
     static const uint32_t CANCEL_MAX_MS    = 1500;
+
+    static const int JOG_REDISPLAY_MS  = 16;  // ~60 Hz while jogging
+    static const int IDLE_REDISPLAY_MS = 50;
     int      _mpg_accum        = 0;
     uint32_t _last_mpg_ms      = 0;
     uint32_t _last_mpg_tick_ms = 0;
@@ -141,6 +146,8 @@ private:
     uint32_t _cancel_req_ms    = 0;
     uint32_t _last_cancel_ms   = 0;
 
+    StaticLayer _static_layer;  // Background, dial graphic and title
+
 public:
     MultiJogScene() : Scene("Jog", 4, jog_help_text) {}
 
@@ -175,6 +182,11 @@ public:
         const uint16_t sep_color     = 0x0000;  // black
         const uint16_t outline_color = 0x8410;
 
+        // Drawn with canvas primitives directly, so record the damage here
+        mark_dirty(cx - R, cy - R, 2 * R + 1, 2 * R + 1);
+        hash_draw(OP_JOG_DIAL, cx, cy, R, ri, hw);
+        hash_draw(OP_JOG_DIAL, zone_color, sep_color, outline_color);
+
         // Fill entire outer disc with blue, then overlay separators + center
         canvas.fillCircle(cx, cy, R, zone_color);
 
@@ -224,9 +236,13 @@ public:
     }
 
     void reDisplay() {
-        background();
-        drawJogBg();
-        drawMenuTitle("Jog");
+        // The dial graphic and title never change, so draw them once
+        if (!_static_layer.restore()) {
+            background();
+            drawJogBg();
+            drawMenuTitle("Jog");
+            _static_layer.save();
+        }
         if (state == Idle) {
             centered_text(_dynamic_mode ? "Dynamic" : "Precise", 45, 65535, SMALL);
         } else {
@@ -248,26 +264,30 @@ public:
                     centered_text("Touch to cancel jog", 185, YELLOW, TINY);
                 }
             } else {
-                std::string dialLegend("Zero");
+                char dialLegend[16] = "Zero";
+                int  n              = strlen(dialLegend);
                 for (int axis = 0; axis < num_axes; axis++) {
                     if (selected(axis)) {
-                        dialLegend += axisNumToChar(axis);
+                        dialLegend[n++] = axisNumToChar(axis);
                     }
                 }
-                drawButtonLegends("Jog-", "Jog+", dialLegend.c_str());
+                dialLegend[n] = '\0';
+                drawButtonLegends("Jog-", "Jog+", dialLegend);
             }
         }
         refreshDisplay();
     }
     void zero_axes() {
-        std::string cmd = "G10L20P0";
+        char cmd[32] = "G10L20P0";
+        int  n       = strlen(cmd);
         for (int axis = 0; axis < num_axes; axis++) {
             if (selected(axis)) {
-                cmd += axisNumToChar(axis);
-                cmd += "0";
+                cmd[n++] = axisNumToChar(axis);
+                cmd[n++] = '0';
             }
         }
-        send_line(cmd.c_str());
+        cmd[n] = '\0';
+        send_line(cmd);
     }
     void onEntry(void* arg) {
         if (arg && strcmp((const char*)arg, "Confirmed") == 0) {
@@ -279,6 +299,9 @@ public:
             }
             getPref("JogMode", &_dynamic_mode);
         }
+        // Send the faster $RI now, so that it cannot land between the
+        // first jog lines and their oks
+        service_report_interval();
     }
 
     int which(int x, int y) {
@@ -289,16 +312,17 @@ public:
     }
 
     void confirm_zero_axes() {
-        std::string confirmMsg("Zero ");
+        char confirmMsg[16] = "Zero ";
+        int  n              = strlen(confirmMsg);
 
         for (int axis = 0; axis < num_axes; axis++) {
             if (selected(axis)) {
-                confirmMsg += axisNumToChar(axis);
+                confirmMsg[n++] = axisNumToChar(axis);
             }
         }
-        confirmMsg += " ?";
-        dbg_println(confirmMsg.c_str());
-        push_scene(&confirmScene, (void*)confirmMsg.c_str());
+        strcpy(confirmMsg + n, " ?");
+        dbg_println(confirmMsg);
+        push_scene(&confirmScene, (void*)confirmMsg);
     }
     void set_dist_index(int axis, int value) {
         _dist_index[axis] = value;
@@ -497,17 +521,15 @@ public:
     }
 
     void send_mpg_jog(int delta, e4_t feed) {
-        std::string cmd("$J=G91");
-        cmd += inInches ? "G20" : "G21";
-        cmd += "F";
-        cmd += e4_to_cstr(feed, 0);
+        char cmd[100];
+        int  n = snprintf(cmd, sizeof(cmd), "$J=G91%sF%s", inInches ? "G20" : "G21", e4_to_cstr(feed, 0));
         for (int axis = 0; axis < num_axes; ++axis) {
             if (selected(axis)) {
-                cmd += axisNumToChar(axis);
-                cmd += e4_to_cstr(delta * distance(axis), inInches ? 3 : 2);
+                n += snprintf(cmd + n, sizeof(cmd) - n, "%c%s", axisNumToChar(axis), e4_to_cstr(delta * distance(axis), inInches ? 3 : 2));
             }
         }
-        send_jog_line(cmd.c_str());
+        jog_latency_sent();
+        send_jog_line(cmd);
         _mpg_jogging = true;
     }
     void start_button_jog(bool negative) {
@@ -523,10 +545,8 @@ public:
 
         e4_t feedrate = total_distance * 300;  // go 5x the highlighted distance in 1 second
 
-        std::string cmd("$J=G91");
-        cmd += inInches ? "G20" : "G21";
-        cmd += "F";
-        cmd += e4_to_cstr(feedrate, 3);
+        char cmd[100];
+        int  n = snprintf(cmd, sizeof(cmd), "$J=G91%sF%s", inInches ? "G20" : "G21", e4_to_cstr(feedrate, 3));
         for (int axis = 0; axis < num_axes; ++axis) {
             if (selected(axis)) {
                 e4_t axis_distance;
@@ -538,11 +558,11 @@ public:
                 if (negative) {
                     axis_distance = -axis_distance;
                 }
-                cmd += axisNumToChar(axis);
-                cmd += e4_to_cstr(axis_distance, 0);
+                n += snprintf(cmd + n, sizeof(cmd) - n, "%c%s", axisNumToChar(axis), e4_to_cstr(axis_distance, 0));
             }
         }
-        send_jog_line(cmd.c_str());
+        jog_latency_sent();
+        send_jog_line(cmd);
         _continuous = true;
     }
 
@@ -614,7 +634,6 @@ public:
         int      acc = _mpg_accum;  // captured for trace
         uint32_t t0  = millis();
         send_mpg_jog(_mpg_accum, feed);
-        jog_mark_sent();
         uint32_t blk = millis() - t0;  // time spent ack-gated waiting for the prior "ok"
         _jog_dir = dir;
 
@@ -648,7 +667,6 @@ public:
             int      acc = _mpg_accum;
             uint32_t t0  = millis();
             send_mpg_jog(_mpg_accum, e4_from_int(inInches ? 400 : 10000));
-            jog_mark_sent();
             JOG_DBG("J P t=%u a=%d b=%u\n", (unsigned)now, acc, (unsigned)(millis() - t0));
             _mpg_accum   = 0;
             _last_mpg_ms = now;
@@ -669,6 +687,7 @@ public:
     }
 
     void onEncoder(int delta) {
+        jog_latency_tick();
         _mpg_accum += delta;
         _last_mpg_tick_ms = millis();
         if (dynamic_jog_active()) {
@@ -708,11 +727,27 @@ public:
         }
     }
 
-    void onDROChange() {
-        reDisplay();
+    void onDROChange(uint32_t changes) {
+        request_redisplay();
+    }
+    uint32_t modelInterest() override {
+        return MODEL_STATE | MODEL_AXES | MODEL_LIMITS | MODEL_MODES;
+    }
+    bool extrapolateDRO() override {
+        return true;
+    }
+    int reportInterval() override {
+        // Fast for as long as the scene is up, not just while jogging,
+        // so that the rate never changes between jog commands
+        return REPORT_FAST_MS;
     }
     void onLimitsChange() {
-        reDisplay();
+        request_redisplay();
+    }
+    int redisplayInterval() override {
+        // Follow the dial closely while it moves or the machine is jogging
+        bool dial_moving = _last_mpg_tick_ms != 0 && (millis() - _last_mpg_tick_ms) < MPG_STOP_MS;
+        return (state == Jog || dial_moving) ? JOG_REDISPLAY_MS : IDLE_REDISPLAY_MS;
     }
     void onAlarm() {
         reDisplay();
@@ -12,6 +12,7 @@
 #include "FluidNCModel.h"
 #include "System.h"
 #include "Scene.h"
+#include "Metrics.h"
 
 #include <esp_now.h>
 #include <WiFi.h>
@@ -508,21 +509,46 @@ static bool register_peer(const uint8_t mac[6], uint8_t channel, bool encrypt, c
     return result == ESP_OK;
 }
 
+static Counter rx_dropped("espnow.rx_dropped");  // Only the receive callback writes it
+
 static inline void rx_push(uint8_t c) {
     int cur  = _rx_head.load(std::memory_order_relaxed);
     int next = (cur + 1) % RX_BUF_SIZE;
     if (next != _rx_tail) {
         _rx_buf[cur] = c;
         _rx_head.store(next, std::memory_order_release);
+    } else {
+        ++rx_dropped;
     }
 }
 
-static inline int rx_pop() {
-    int head = _rx_head.load(std::memory_order_acquire);
-    if (head == _rx_tail) return -1;
-    uint8_t c = _rx_buf[_rx_tail];
-    _rx_tail  = (_rx_tail + 1) % RX_BUF_SIZE;
-    return (unsigned char)c;
+// Append n bytes to the ring with at most two memcpy()s, publishing them
+// with a single head update.  What does not fit is dropped.
+static void rx_push_run(const uint8_t* p, size_t n) {
+    int    cur  = _rx_head.load(std::memory_order_relaxed);
+    size_t room = (_rx_tail - cur - 1 + RX_BUF_SIZE) % RX_BUF_SIZE;
+    if (n > room) {
+        rx_dropped += n - room;
+        n = room;
+    }
+    size_t first = RX_BUF_SIZE - cur;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(&_rx_buf[cur], p, first);
+    memcpy(_rx_buf, p + first, n - first);
+    _rx_head.store((cur + n) % RX_BUF_SIZE, std::memory_order_release);
+}
+
+// Append a payload to the ring, dropping CRs; GrblParser wants LF-terminated lines
+static void rx_push_span(const uint8_t* p, size_t n) {
+    const uint8_t* end = p + n;
+    while (p < end) {
+        const uint8_t* cr  = (const uint8_t*)memchr(p, '\r', end - p);
+        const uint8_t* run = cr ? cr : end;
+        rx_push_run(p, run - p);
+        p = run + 1;
+    }
 }
 
 static void set_connected_now() {
@@ -1024,6 +1050,18 @@ static void process_rx_packet(const RxPacket& packet) {
         return;
     }
 
+    // Most lines fit in one fragment; those go straight from the packet to the ring
+    if (total == 1) {
+        const uint8_t* payload = data + FRAG_HEADER_SIZE;
+        rx_push_span(payload, (size_t)plen);
+        if (plen == 0 || payload[plen - 1] != '\n') {
+            rx_push('\n');
+        }
+        _frag_pending = false;
+        update_rx_time();
+        return;
+    }
+
     memcpy(_frag_buf[idx], data + FRAG_HEADER_SIZE, (size_t)plen);
     _frag_len[idx] = (uint8_t)plen;
     _frag_got |= (uint8_t)(1u << idx);
@@ -1034,12 +1072,7 @@ static void process_rx_packet(const RxPacket& packet) {
     }
 
     for (int i = 0; i < total; ++i) {
-        for (int j = 0; j < _frag_len[i]; ++j) {
-            uint8_t c = _frag_buf[i][j];
-            if (c != '\r') {
-                rx_push(c);
-            }
-        }
+        rx_push_span(_frag_buf[i], _frag_len[i]);
     }
     if (_frag_len[total - 1] == 0 ||
         _frag_buf[total - 1][_frag_len[total - 1] - 1] != '\n') {
@@ -1487,8 +1520,17 @@ void espnow_putchar(uint8_t c) {
     }
 }
 
-int espnow_getchar() {
-    return rx_pop();
+// The oldest received bytes that are contiguous in the ring, read in place.
+// Bytes the receive callback adds meanwhile are left for the next slice.
+size_t espnow_rx_slice(const uint8_t** data) {
+    int head = _rx_head.load(std::memory_order_acquire);
+    int end  = head >= _rx_tail ? head : RX_BUF_SIZE;
+    *data    = &_rx_buf[_rx_tail];
+    return end - _rx_tail;
+}
+
+void espnow_rx_release(size_t n) {
+    _rx_tail = (_rx_tail + n) % RX_BUF_SIZE;
 }
 
 bool espnow_rx_available() {
@@ -1836,7 +1878,8 @@ void espnow_clear_pairing() {
 void        espnow_init() {}
 void        espnow_poll() {}
 void        espnow_putchar(uint8_t) {}
-int         espnow_getchar() { return -1; }
+size_t      espnow_rx_slice(const uint8_t** data) { return 0; }
+void        espnow_rx_release(size_t n) {}
 bool        espnow_rx_available() { return false; }
 bool        espnow_is_paired() { return false; }
 bool        espnow_is_connected() { return false; }
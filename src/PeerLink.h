@@ -20,7 +20,8 @@ void espnow_poll();
 
 
 void espnow_putchar(uint8_t c);
-int  espnow_getchar();  // returns -1 if no data
+size_t espnow_rx_slice(const uint8_t** data);  // received bytes read in place; see FncRx.h
+void espnow_rx_release(size_t n);
 bool espnow_rx_available();  // true if a received byte is buffered
 
 
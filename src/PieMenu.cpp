@@ -69,7 +69,22 @@ int PieMenu::touchedItem(int x, int y) {
     return x > 0 ? i : num_items() - i;
 }
 void PieMenu::menuBackground() {
-    background();
+    // The background and the icons in their unhighlighted form only change
+    // when the items do, so draw them once and cache them.
+    if (!_static_layer.restore(num_items())) {
+        background();
+        for (size_t i = 0; i < num_items(); ++i) {
+            bool highlighted = _items[i]->highlighted();
+            _items[i]->unhighlight();
+            _items[i]->show(_positions[i]);
+            if (highlighted) {
+                _items[i]->highlight();
+            }
+        }
+        _static_layer.save(num_items());
+    }
+    _items_in_background = true;
+
     text(selectedItem()->name(), { 0, round_display ? -20 : -15 }, WHITE, SMALL);
     drawStatusSmall(round_display ? 95 : 90);
 #if defined(USE_WIFI) || defined(USE_M5)
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Menu.h"
+#include "StaticLayer.h"
 
 // Pie menus were originally invented by Don Hopkins at Sun Microsystems
 class PieMenu : public Menu {
@@ -13,6 +14,8 @@ private:
 
     std::vector<int> _slopes;  // Slopes of lines dividing switch positions
 
+    StaticLayer _static_layer;  // Background and unhighlighted items
+
 public:
     PieMenu(const char* name, int item_radius, const char** help_text = nullptr) : Menu(name, help_text), _item_radius(item_radius) {}
     PieMenu(const char* name, int item_radius, int num_items, const char** help_text = nullptr) :
@@ -29,6 +32,7 @@ public:
     void addItem(Item* item) {
         Menu::addItem(item);
         calculatePositions();
+        _static_layer.invalidate();
     }
     int  touchedItem(int x, int y) override;
     void onStateChange(state_t old_state) override;
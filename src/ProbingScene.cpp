@@ -3,6 +3,7 @@
 
 #include <string>
 #include "Scene.h"
+#include "Widget.h"
 #include "e4math.h"
 
 class ProbingScene : public Scene {
@@ -17,6 +18,21 @@ private:
     int  _retract = 20;
     int  _axis    = 2;  // Z is default
 
+    // The body is the settings form when Idle, the probe DRO while probing,
+    // or empty; switching between them starts over from the background.
+    enum body_t { NO_BODY, FORM_BODY, DRO_BODY };
+
+    WidgetList   _widgets;
+    TitleWidget  _title;
+    StatusWidget _status;
+    StripeWidget _form[5]  = { { 40, 62, 160, 25 }, { 40, 88, 160, 25 }, { 40, 114, 160, 25 }, { 40, 140, 160, 25 }, { 40, 166, 160, 25 } };
+    StripeWidget _dro[3]   = { { 14, 65, 212, 35, MEDIUM_MONO }, { 14, 101, 212, 35, MEDIUM_MONO }, { 14, 137, 212, 35, MEDIUM_MONO } };
+    LEDWidget    _probe    = { 120, 190, 10 };
+    LegendWidget _legends;
+    bool         _redraw_all  = true;
+    body_t       _body        = NO_BODY;
+    bool         _error_shown = false;
+
 public:
     ProbingScene() : Scene("Probe") {}
 
@@ -62,7 +78,9 @@ public:
         ackBeep();
     }
 
-    void onDROChange() { reDisplay(); }
+    void     onDROChange(uint32_t changes) { request_redisplay(); }
+    uint32_t modelInterest() override { return MODEL_STATE | MODEL_AXES | MODEL_LIMITS | MODEL_MODES; }
+    int      reportInterval() override { return state == Cycle ? REPORT_FAST_MS : REPORT_NORMAL_MS; }  // Probing runs as Cycle
 
     void onEncoder(int delta) {
         if (abs(delta) > 0) {
@@ -105,55 +123,60 @@ public:
             getPref("Retract", &_retract);
             getPref("Axis", &_axis);
         }
+        _widgets.clear();
+        _widgets.add(&_title);
+        _widgets.add(&_status);
+        for (auto& row : _form) {
+            _widgets.add(&row);
+        }
+        for (auto& dro : _dro) {
+            _widgets.add(&dro);
+        }
+        _widgets.add(&_probe);
+        _widgets.add(&_legends);
+        _redraw_all = true;
     }
 
     void reDisplay() {
-        background();
-        drawMenuTitle(current_scene->name());
-        drawStatus();
+        body_t body = NO_BODY;
+        if (state == Idle) {
+            body = FORM_BODY;
+        } else if (state != Jog && state != Alarm) {  // there is no Probing state, so Cycle is a valid state on this
+            body = DRO_BODY;
+        }
+        // drawError() paints over the body for a while, so start over both
+        // when an error appears and when it goes away
+        bool error_shown = lastError != 0;
+        if (_redraw_all || body != _body || error_shown != _error_shown) {
+            background();
+            _widgets.invalidate();
+            _redraw_all  = false;
+            _body        = body;
+            _error_shown = error_shown;
+        }
+        _title.set(current_scene->name());
+        _status.update();
 
         const char* grnLabel = "";
         const char* redLabel = "";
 
-        if (state == Idle) {
-            int    x      = 40;
-            int    y      = 62;
-            int    width  = display_short_side() - (x * 2);
-            int    height = 25;
-            int    pitch  = 27;  // for spacing of buttons
-            Stripe button(x, y, width, height, TINY);
-            button.draw("Offset", e4_to_cstr(_offset, 2), selection == 0);
-            button.draw("Max Travel", intToCStr(_travel), selection == 1);
-            y = button.y();  // For LED
-            button.draw("Feed Rate", intToCStr(_rate), selection == 2);
-
-            button.draw("Retract", intToCStr(_retract), selection == 3);
-            button.draw("Axis", axisNumToCStr(_axis), selection == 4);
-
-            //LED led(x - 20, y + height / 2, 10, button.gap());
-            //led.draw(myProbeSwitch);
-
-            grnLabel = "Probe";
-            redLabel = "Retract";
-        } else {
-            if (state == Jog || state == Alarm) {  // there is no Probing state, so Cycle is a valid state on this
-                //centered_text("Invalid State", 105, WHITE, MEDIUM);
-                //centered_text("For Probing", 145, WHITE, MEDIUM);
-                redLabel = "Reset";
-                grnLabel = "Unlock";
-            } else {
-                int x      = 14;
-                int height = 35;
-                int y      = 82 - height / 2;
+        switch (body) {
+            case FORM_BODY:
+                _form[0].set("Offset", e4_to_cstr(_offset, 2), selection == 0);
+                _form[1].set("Max Travel", intToCStr(_travel), selection == 1);
+                _form[2].set("Feed Rate", intToCStr(_rate), selection == 2);
+                _form[3].set("Retract", intToCStr(_retract), selection == 3);
+                _form[4].set("Axis", axisNumToCStr(_axis), selection == 4);
 
-                LED led(120, 190, 10, 5);
-                led.draw(myProbeSwitch);
-
-                int width = display_short_side() - x * 2;
-                DRO dro(x, y, width, height);
-                dro.draw(0, _axis == 0);
-                dro.draw(1, _axis == 1);
-                dro.draw(2, _axis == 2);
+                grnLabel = "Probe";
+                redLabel = "Retract";
+                break;
+            case DRO_BODY:
+                _probe.set(myProbeSwitch);
+                for (int axis = 0; axis < 3; axis++) {
+                    char label[2] = { axisNumToChar(axis), '\0' };
+                    _dro[axis].set(label, pos_to_cstr(dro_axis(axis), num_digits()), _axis == axis, myLimitSwitches[axis] ? GREEN : WHITE);
+                }
 
                 switch (state) {
                     case Cycle:
@@ -166,10 +189,14 @@ public:
                         grnLabel = "Resume";
                         break;
                 }
-            }
+                break;
+            case NO_BODY:
+                redLabel = "Reset";
+                grnLabel = "Unlock";
+                break;
         }
 
-        drawButtonLegends(redLabel, grnLabel, "Back");
+        _legends.set(redLabel, grnLabel, "Back");
         drawError();  // only if one just happened
         refreshDisplay();
     }
@@ -4,6 +4,10 @@
 #include "Scene.h"
 #include "ConfigItem.h"
 #include "System.h"
+#include "Metrics.h"
+#include "SpanTrace.h"
+#include "HeapStats.h"
+#include "AllocProfile.h"
 #ifdef USE_WIFI
 #    include "WiFiConnection.h"
 #endif
@@ -27,6 +31,7 @@ int touchDeltaY;
 std::vector<Scene*> scene_stack;
 
 void activate_scene(Scene* scene, void* arg) {
+    TRACE_SPAN_DETAIL("activate_scene", scene->name());
     bool prev_show = !current_scene || current_scene->showButtons();
     if (current_scene) {
         current_scene->onExit();
@@ -66,7 +71,10 @@ bool touchIsCenter() {
     return (ctr.x * ctr.x + ctr.y * ctr.y) < (center_radius * center_radius);
 }
 
+static uint32_t s_last_input_ms = 0;
+
 void dispatch_button(bool pressed, int button) {
+    TRACE_SPAN_DETAIL("onButton", current_scene->name());
     switch (button) {
         case 0:
             if (pressed) {
@@ -99,6 +107,8 @@ void dispatch_touch() {
     auto t = touch.getDetail();
     if (t.state != last_touch_state) {
         last_touch_state = t.state;
+        s_last_input_ms  = millis();
+        TRACE_SPAN_DETAIL("onTouch", current_scene->name());
         touchX           = t.x - sprite_offset.x;
         touchY           = t.y - sprite_offset.y;
         int delta;
@@ -162,25 +172,49 @@ void schedule_action(ActionHandler _action) {
 // Coalesced redraw bookkeeping. See Scene.h for rationale.
 static volatile bool s_redisplay_dirty   = false;
 static uint32_t      s_last_redisplay_ms = 0;
+static uint32_t      s_render_us         = 0;  // Moving average of reDisplay() time
+static HistogramMetric s_render_hist("scene.render_us");
+static Gauge           s_interval_gauge("scene.interval_ms", [] { return (int32_t)redisplay_interval_ms(); });
+
+// Percentage of the loop that rendering may take before the governor backs off
+static const int RENDER_SHARE_PCT = 50;
 
 void request_redisplay() {
     s_redisplay_dirty = true;
 }
 
+int redisplay_interval_ms() {
+    int interval = current_scene ? current_scene->redisplayInterval() : UPDATE_RATE_MS;
+    int backoff  = s_render_us * (100 / RENDER_SHARE_PCT) / 1000;
+    return interval > backoff ? interval : backoff;
+}
+
+uint32_t redisplay_render_us() {
+    return s_render_us;
+}
+
 void service_redisplay() {
     if (!s_redisplay_dirty) {
         return;
     }
     uint32_t now = millis();
-    // Cap UI refresh to UPDATE_RATE_MS (~30 ms). Multiple parser callbacks
-    // in the same window collapse to one reDisplay.
-    if ((int32_t)(now - s_last_redisplay_ms) < (int32_t)UPDATE_RATE_MS) {
+    // Multiple parser callbacks in the same window collapse to one reDisplay.
+    if ((int32_t)(now - s_last_redisplay_ms) < redisplay_interval_ms()) {
         return;
     }
     s_redisplay_dirty   = false;
     s_last_redisplay_ms = now;
     if (current_scene) {
+        TRACE_SPAN_DETAIL("reDisplay", current_scene->name());
+        HeapScope heap_scope(HEAP_SCENE);
+        uint32_t start = microseconds();
+        alloc_profile_frame_begin();
         current_scene->reDisplay();
+        alloc_profile_frame_end(current_scene->name());
+        int32_t elapsed = microseconds() - start;
+        s_render_hist.add(elapsed);
+        // Weight each new sample by 1/8
+        s_render_us += (elapsed - (int32_t)s_render_us) / 8;
     }
 }
 
@@ -192,10 +226,12 @@ void dispatch_events() {
     int16_t        newEncoder   = get_encoder();
     int16_t        encoderDelta = newEncoder - oldEncoder;
     if (encoderDelta) {
-        oldEncoder = newEncoder;
+        oldEncoder      = newEncoder;
+        s_last_input_ms = millis();
 
         int16_t scaledDelta = current_scene->scale_encoder(encoderDelta);
         if (scaledDelta && !ui_locked()) {
+            TRACE_SPAN_DETAIL("onEncoder", current_scene->name());
             current_scene->onEncoder(scaledDelta);
         }
     }
@@ -204,13 +240,22 @@ void dispatch_events() {
         bool pressed;
         int  button;
         if (switch_button_touched(pressed, button)) {
+            s_last_input_ms = millis();
             dispatch_button(pressed, button);
         }
 
         dispatch_touch();
     }
 
-    current_scene->onPoll();
+    {
+        TRACE_SPAN_OVER("onPoll", 100);
+        current_scene->onPoll();
+    }
+
+    // The governor spaces these redraws at the scene's redisplayInterval()
+    if (dro_extrapolating() && current_scene->extrapolateDRO()) {
+        request_redisplay();
+    }
 
     if (!fnc_is_connected()) {
         if (state != Disconnected) {
@@ -223,12 +268,32 @@ void dispatch_events() {
             fnc_realtime(StatusReport);
         }
     }
+    service_report_interval();
+
     if (action) {
         action();
         action = nullptr;
     }
 }
 
+uint32_t last_input_ms() {
+    return s_last_input_ms;
+}
+
+int Scene::reportInterval() {
+    switch (state) {
+        case Cycle:
+        case Hold:
+        case Jog:
+        case Homing:
+        case DoorOpen:
+        case DoorClosed:
+            return REPORT_NORMAL_MS;
+        default:
+            return REPORT_SLOW_MS;
+    }
+}
+
 static const char* setting_name(const char* base_name, int axis) {
     static char name[32];
     if (axis == -1) {
@@ -286,9 +351,11 @@ int Scene::scale_encoder(int delta) {
 }
 
 void Scene::background() {
+    mark_all_dirty();
     system_background();
 }
 
 void act_on_state_change() {
+    TRACE_SPAN_DETAIL("onStateChange", current_scene->name());
     current_scene->onStateChange(previous_state);
 }
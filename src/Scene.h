@@ -52,7 +52,21 @@ public:
     virtual void onError(const char* errstr) {}
 
     virtual void onStateChange(state_t) {}
-    virtual void onDROChange() {}
+
+    // changes holds the MODEL_* parts that the last status report changed,
+    // restricted to modelInterest(); not called when that is none of them
+    virtual void     onDROChange(uint32_t changes) {}
+    virtual uint32_t modelInterest() { return MODEL_ALL; }
+
+    // True to be redrawn between status reports while the DRO is being
+    // extrapolated (see dro_axis())
+    virtual bool extrapolateDRO() { return false; }
+
+    // The auto-report interval this scene wants in the current machine
+    // state (see service_report_interval()).  By default REPORT_NORMAL_MS
+    // while the machine is busy and REPORT_SLOW_MS otherwise.
+    virtual int reportInterval();
+
     virtual void onLimitsChange() {}
     virtual void onMessage(char* command, char* arguments) {}
     virtual void onEncoder(int delta) {}
@@ -63,6 +77,10 @@ public:
 
     virtual bool showButtons() { return true; }
 
+    // Preferred minimum time in milliseconds between coalesced redraws, in
+    // the current machine state.  See service_redisplay().
+    virtual int redisplayInterval() { return UPDATE_RATE_MS; }
+
     virtual void onFileLines(int firstline, const std::vector<std::string>& lines) {}
     virtual void onFilesList() {}
 
@@ -120,13 +138,25 @@ void schedule_action(ActionHandler action);
 // heap allocator, and starves WiFi RX / touch handling.
 //
 // Use request_redisplay() instead. It sets a dirty flag; service_redisplay()
-// runs once per main-loop tick (rate-limited to UPDATE_RATE_MS) and issues
-// a single coalesced reDisplay if anything asked for one. Multiple requests
-// in the same tick collapse to one redraw.
+// runs once per main-loop tick and issues a single coalesced reDisplay if
+// anything asked for one. Multiple requests in the same tick collapse to one
+// redraw.
+//
+// The rate is set by a governor: the current scene's redisplayInterval()
+// gives the preferred spacing, and if rendering takes more than half of
+// that, the spacing stretches to twice the average render time so that RX
+// processing and input sampling always get at least half of the loop.
 void request_redisplay();
 void service_redisplay();
 
+// The spacing the governor is currently using, and the average reDisplay() time
+int      redisplay_interval_ms();
+uint32_t redisplay_render_us();
+
 extern Scene* current_scene;
 
 void dispatch_events();
 void act_on_state_change();
+
+// millis() of the last encoder, button or touch event
+uint32_t last_input_ms();
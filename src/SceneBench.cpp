@@ -0,0 +1,135 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "SceneBench.h"
+
+#ifdef SCENE_BENCH
+#    include "Scene.h"
+#    include "FileParser.h"
+#    include "HeapStats.h"  // heap_allocations()
+#    include <algorithm>
+#    include <vector>
+
+extern Scene statusScene;
+extern Scene multiJogScene;
+extern Scene fileSelectScene;
+extern Scene menuScene;
+extern Scene filePreviewScene;
+
+// Scripted model state, as a connected controller would have reported it
+static void script_model(state_t new_state, const char* state_string) {
+    state           = new_state;
+    my_state_string = state_string;
+    n_axes          = 3;
+    myAxes[0]       = atopos("123.4567");
+    myAxes[1]       = atopos("-45.0100");
+    myAxes[2]       = atopos("7.5000");
+    myPercent       = 42;
+    myFro           = 100;
+    mySro           = 100;
+    myFeed          = 1200;
+    mySpeed         = 12000;
+    lastAlarm       = 0;
+    lastError       = 0;
+    myFile          = "bracket.nc";
+
+    fileVector.clear();
+    static const char* names[] = { "bracket.nc", "enclosure_lid.gcode", "fixtures", "logo_engrave.nc", "spoilboard_surface.nc", "test.nc" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        fileVector.push_back({ names[i], i == 2 ? -1 : 10000 * (int)(i + 1) });
+    }
+
+    if (macros.empty()) {
+        static const char* macro_names[] = { "Park", "Probe Z", "Tool Length", "Spindle Warmup" };
+        for (auto name : macro_names) {
+            macros.push_back(new Macro { name, "/localfs/macro.nc", "" });
+        }
+    }
+}
+
+static void preview_lines(Scene* scene) {
+    std::vector<std::string> lines = {
+        "G21 G90 G94", "G0 Z5.000", "G0 X0.000 Y0.000", "M3 S12000", "G1 Z-1.000 F300", "G1 X40.000 F1200", "G1 Y25.000",
+    };
+    scene->onFileLines(0, lines);
+}
+
+struct BenchCase {
+    const char* label;
+    Scene*      scene;
+    state_t     state;
+    const char* state_string;
+    void*       arg;
+    void (*prepare)(Scene*);
+};
+
+// Returns false if a frame went over the allocation budget
+static bool run_case(const BenchCase& bc) {
+    script_model(bc.state, bc.state_string);
+    activate_at_top_level(bc.scene, bc.arg);
+    if (bc.prepare) {
+        bc.prepare(bc.scene);
+    }
+
+    std::vector<uint32_t> times;
+    times.reserve(SCENE_BENCH_ITERATIONS);
+    uint64_t pixels          = 0;
+    uint32_t max_allocs      = 0;
+    int      bytes_per_pixel = ((int)display.getColorDepth() & 0xff) / 8;
+    pos_t    step            = atopos("0.0123");
+
+    for (int i = 0; i < SCENE_BENCH_ITERATIONS; i++) {
+        // Motion, so DRO-driven scenes have something to redraw
+        myAxes[0] += step;
+        myAxes[1] -= step;
+        uint32_t allocs = heap_allocations();
+        uint32_t start  = microseconds();
+        bc.scene->reDisplay();
+        times.push_back(microseconds() - start);
+        allocs = heap_allocations() - allocs;
+        if (i >= SCENE_BENCH_WARMUP && allocs > max_allocs) {
+            max_allocs = allocs;
+        }
+        pixels += display_bytes_pushed() / bytes_per_pixel;
+    }
+
+    std::sort(times.begin(), times.end());
+    size_t n = times.size();
+    bool over = max_allocs > (uint32_t)SCENE_BENCH_ALLOC_BUDGET;
+    dbg_printf("%-22s min %6u us  median %6u us  p99 %6u us  pixels/frame %6u  allocs/frame %3u%s\n",
+               bc.label,
+               times[0],
+               times[n / 2],
+               times[std::min(n - 1, n * 99 / 100)],
+               (unsigned)(pixels / n),
+               max_allocs,
+               over ? "  OVER BUDGET" : "");
+    return !over;
+}
+
+int scene_bench() {
+    static char preview_name[] = "bracket.nc";
+
+    const BenchCase cases[] = {
+        { "statusScene/Cycle", &statusScene, Cycle, "Run", nullptr, nullptr },
+        { "statusScene/Idle", &statusScene, Idle, "Idle", nullptr, nullptr },
+        { "multiJogScene/Jog", &multiJogScene, Jog, "Jog", nullptr, nullptr },
+        { "multiJogScene/Idle", &multiJogScene, Idle, "Idle", nullptr, nullptr },
+        { "fileSelectScene", &fileSelectScene, Idle, "Idle", nullptr, nullptr },
+        { "menuScene", &menuScene, Idle, "Idle", nullptr, nullptr },
+        { "filePreviewScene", &filePreviewScene, Idle, "Idle", preview_name, preview_lines },
+    };
+
+    dbg_printf("Scene render benchmark, %d frames per scene\n", SCENE_BENCH_ITERATIONS);
+    int failed = 0;
+    for (auto& bc : cases) {
+        if (!run_case(bc)) {
+            ++failed;
+        }
+    }
+    if (failed) {
+        dbg_printf("%d scenes over their allocation budget\n", failed);
+        return 1;
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,36 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Scene render benchmark.
+//
+// Built with -DSCENE_BENCH (see [env:linux_bench] in platformio.ini).  After
+// setup(), main() calls scene_bench() instead of running the event loop.
+// Each benchmarked scene is activated against a scripted model state, then
+// reDisplay()ed SCENE_BENCH_ITERATIONS times while the DRO moves a little
+// on every frame, as it does during a job.  For each scene the report gives
+// the min, median and 99th percentile reDisplay() time, the pixels pushed
+// to the panel and the most heap allocations made by one frame.  The output
+// is plain text, one line per scene, so runs on two branches can be diffed
+// on the same machine.
+//
+// Redrawing a scene whose model only moved should not allocate.  The first
+// SCENE_BENCH_WARMUP frames may fill caches; after that, a frame that makes
+// more than SCENE_BENCH_ALLOC_BUDGET allocations fails the benchmark with a
+// nonzero exit status.  The budget is the same for every scene: none of
+// them should allocate once their caches are filled.
+
+#pragma once
+
+#ifndef SCENE_BENCH_ITERATIONS
+#    define SCENE_BENCH_ITERATIONS 200
+#endif
+
+#ifndef SCENE_BENCH_WARMUP
+#    define SCENE_BENCH_WARMUP 2
+#endif
+
+#ifndef SCENE_BENCH_ALLOC_BUDGET
+#    define SCENE_BENCH_ALLOC_BUDGET 0
+#endif
+
+// Returns the process exit status
+int scene_bench();
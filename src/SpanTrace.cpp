@@ -0,0 +1,82 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "SpanTrace.h"
+
+#if defined(SPAN_TRACE) && !defined(ARDUINO)
+#    include "System.h"  // dbg_printf()
+#    include <chrono>
+#    include <cstdio>
+#    include <cstdlib>
+#    include <vector>
+
+struct SpanEvent {
+    const char* name;
+    const char* detail;
+    uint64_t    start_us;
+    uint32_t    dur_us;
+};
+
+static std::vector<SpanEvent> events;
+static uint32_t               dropped = 0;
+
+static uint64_t wall_us() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// SDL turns SIGINT and SIGTERM into SDL_QUIT, like closing the window, and
+// update_events() then exits normally, so this also runs after a Ctrl-C
+static void save_at_exit() {
+    span_trace_save(SPAN_TRACE_FILE);
+}
+
+static void start_recording() {
+    events.reserve(1 << 16);
+    atexit(save_at_exit);
+}
+
+TraceSpan::TraceSpan(const char* name, const char* detail, uint32_t min_us) :
+    _name(name), _detail(detail), _min_us(min_us), _start_us(wall_us()) {}
+
+TraceSpan::~TraceSpan() {
+    static bool started = false;
+    if (!started) {
+        started = true;
+        start_recording();
+    }
+    uint32_t dur = wall_us() - _start_us;
+    if (dur < _min_us) {
+        return;
+    }
+    if (events.size() >= SPAN_TRACE_MAX_EVENTS) {
+        ++dropped;
+        return;
+    }
+    events.push_back({ _name, _detail, _start_us, dur });
+}
+
+bool span_trace_save(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    const char* sep = "";
+    for (auto& e : events) {
+        fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%llu,\"dur\":%u", sep, e.name, (unsigned long long)e.start_us, e.dur_us);
+        if (e.detail) {
+            fprintf(f, ",\"args\":{\"detail\":\"%s\"}", e.detail);
+        }
+        fputc('}', f);
+        sep = ",\n";
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    dbg_printf("Saved %u spans to %s", (unsigned)events.size(), path);
+    if (dropped) {
+        dbg_printf(", %u dropped over the limit", dropped);
+    }
+    dbg_printf("\n");
+    return true;
+}
+#endif
@@ -0,0 +1,66 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Scoped span markers exported as a Chrome trace.
+//
+// Host builds with -DSPAN_TRACE.  TRACE_SPAN("name") at the top of a block
+// times the block on the wall clock and records it as a complete ("X")
+// trace event; nested spans nest in the viewer.  Events are kept in memory
+// (up to SPAN_TRACE_MAX_EVENTS) and written as trace-event JSON to
+// SPAN_TRACE_FILE when the program exits, or by span_trace_save().  Load
+// the file in chrome://tracing or ui.perfetto.dev to see how parser
+// callbacks, scene callbacks, redraws and jog sends interleave; a
+// --replay run gives the same picture for a recorded session.
+//
+//   TRACE_SPAN(name)                  name is a string literal
+//   TRACE_SPAN_DETAIL(name, detail)   detail (e.g. a scene name) is shown
+//                                     as an argument; it must outlive the
+//                                     program, as string literals do
+//   TRACE_SPAN_OVER(name, min_us)     only spans that take min_us or more,
+//                                     for paths that run on every loop
+//
+// The spans use the wall clock even while the virtual clock (Clock.h) is
+// driving a replay, so durations are real CPU time.  In firmware builds,
+// and host builds without SPAN_TRACE, the macros compile to nothing.
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef SPAN_TRACE_FILE
+#    define SPAN_TRACE_FILE "spans.json"
+#endif
+
+#ifndef SPAN_TRACE_MAX_EVENTS
+#    define SPAN_TRACE_MAX_EVENTS 2000000
+#endif
+
+#if defined(SPAN_TRACE) && !defined(ARDUINO)
+class TraceSpan {
+public:
+    TraceSpan(const char* name, const char* detail = nullptr, uint32_t min_us = 0);
+    ~TraceSpan();
+
+private:
+    const char* _name;
+    const char* _detail;
+    uint32_t    _min_us;
+    uint64_t    _start_us;
+};
+
+#    define TRACE_SPAN_JOIN2(a, b) a##b
+#    define TRACE_SPAN_JOIN(a, b) TRACE_SPAN_JOIN2(a, b)
+#    define TRACE_SPAN(name) TraceSpan TRACE_SPAN_JOIN(trace_span_, __LINE__)(name)
+#    define TRACE_SPAN_DETAIL(name, detail) TraceSpan TRACE_SPAN_JOIN(trace_span_, __LINE__)(name, detail)
+#    define TRACE_SPAN_OVER(name, min_us) TraceSpan TRACE_SPAN_JOIN(trace_span_, __LINE__)(name, nullptr, min_us)
+
+// Write the events recorded so far; returns false on failure
+bool span_trace_save(const char* path);
+#else
+#    define TRACE_SPAN(name) ((void)0)
+#    define TRACE_SPAN_DETAIL(name, detail) ((void)0)
+#    define TRACE_SPAN_OVER(name, min_us) ((void)0)
+
+inline bool span_trace_save(const char* path) {
+    return false;
+}
+#endif
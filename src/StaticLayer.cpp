@@ -0,0 +1,235 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "StaticLayer.h"
+#include "System.h"
+#include "Drawing.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#ifdef ARDUINO
+#    include <esp_heap_caps.h>
+#endif
+
+struct LayerSlot {
+    uint8_t*     pixels;
+    StaticLayer* owner;
+    uint32_t     last_use;
+};
+
+static LayerSlot slots[STATIC_LAYER_MAX_SLOTS];
+static size_t    slot_bytes = 0;  // Size of every allocated slot
+static uint32_t  use_clock  = 0;
+
+// The layer the canvas was last restored from or saved to.  Apart from what
+// has been drawn since, which take_canvas_damage() reports, the canvas
+// still matches its snapshot.
+static StaticLayer* canvas_layer = nullptr;
+
+// DRO lines that the last restore left on the canvas
+static const int max_kept = 8;
+static CanvasRect kept[max_kept];
+static int        n_kept = 0;
+
+static size_t canvas_bytes() {
+    return canvas.bufferLength();
+}
+
+static int max_slots() {
+    size_t n = canvas_bytes() ? STATIC_LAYER_BUDGET / canvas_bytes() : 0;
+    return n < STATIC_LAYER_MAX_SLOTS ? n : STATIC_LAYER_MAX_SLOTS;
+}
+
+// The canvas size only changes with the hardware layout, but if it does,
+// the slots are the wrong size and have to be allocated again
+static void check_slot_size() {
+    if (slot_bytes == canvas_bytes()) {
+        return;
+    }
+    for (auto& slot : slots) {
+        free(slot.pixels);
+        slot = {};
+    }
+    slot_bytes   = canvas_bytes();
+    canvas_layer = nullptr;
+}
+
+// Copy the rectangle r of the canvas from src to dst, leaving out the
+// parts of r that are in any of the skip rectangles
+static void copy_rect(uint8_t* dst, const uint8_t* src, const CanvasRect& r, const CanvasRect* skip, int n_skip) {
+    int bytes_per_pixel = ((int)canvas.getColorDepth() & 0xff) / 8;
+    int stride          = canvas.width() * bytes_per_pixel;
+    int x0              = std::max(r.x, 0);
+    int y0              = std::max(r.y, 0);
+    int x1              = std::min(r.x + r.width, (int)canvas.width());
+    int y1              = std::min(r.y + r.height, (int)canvas.height());
+    for (int y = y0; y < y1; y++) {
+        size_t row = y * stride;
+        int    x   = x0;
+        while (x < x1) {
+            // Copy up to the nearest skipped span, then continue after it
+            int run_end = x1;
+            int next    = x1;
+            for (int i = 0; i < n_skip; i++) {
+                const CanvasRect& s = skip[i];
+                if (y < s.y || y >= s.y + s.height || s.x + s.width <= x) {
+                    continue;
+                }
+                if (s.x <= x) {
+                    run_end = x;
+                    next    = s.x + s.width;
+                    break;
+                }
+                if (s.x < run_end) {
+                    run_end = s.x;
+                    next    = s.x + s.width;
+                }
+            }
+            if (run_end > x) {
+                memcpy(dst + row + x * bytes_per_pixel, src + row + x * bytes_per_pixel, (run_end - x) * bytes_per_pixel);
+            }
+            x = next;
+        }
+    }
+}
+
+uint8_t* StaticLayer::pixels() {
+    if (_slot < 0 || slots[_slot].owner != this || slot_bytes != canvas_bytes()) {
+        return nullptr;
+    }
+    return slots[_slot].pixels;
+}
+
+bool StaticLayer::claim_slot() {
+    check_slot_size();
+    if (pixels()) {
+        return true;
+    }
+    // A slot no layer is using, or else the least recently used one
+    int n      = max_slots();
+    int chosen = -1;
+    for (int i = 0; i < n; i++) {
+        if (!slots[i].owner) {
+            chosen = i;
+            break;
+        }
+        if (chosen < 0 || slots[i].last_use < slots[chosen].last_use) {
+            chosen = i;
+        }
+    }
+    if (chosen < 0) {
+        return false;
+    }
+    LayerSlot& slot = slots[chosen];
+    if (!slot.pixels) {
+#ifdef ARDUINO
+        if (heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) < slot_bytes + STATIC_LAYER_HEAP_RESERVE) {
+            return false;
+        }
+#endif
+        slot.pixels = (uint8_t*)malloc(slot_bytes);
+        if (!slot.pixels) {
+            return false;
+        }
+    }
+    if (slot.owner == canvas_layer) {
+        canvas_layer = nullptr;
+    }
+    slot.owner = this;
+    _slot      = chosen;
+    return true;
+}
+
+bool StaticLayer::restore(int key) {
+    uint8_t* snapshot = pixels();
+    if (!_valid || _key != key || !snapshot) {
+        return false;
+    }
+    uint8_t*   buffer = (uint8_t*)canvas.getBuffer();
+    CanvasRect damage;
+    bool       drawn = take_canvas_damage(damage);
+    bool       whole = drawn && damage.width == canvas.width() && damage.height == canvas.height();
+    if (canvas_layer != this || whole) {
+        // The canvas holds something else entirely, such as another scene
+        // that has drawn its background over it
+        memcpy(buffer, snapshot, slot_bytes);
+        mark_all_dirty();
+        take_canvas_damage(damage);
+        n_kept       = 0;
+        canvas_layer = this;
+    } else {
+        n_kept = dro_keep_lines(kept, max_kept);
+        if (drawn) {
+            copy_rect(buffer, snapshot, damage, kept, n_kept);
+            mark_restored(damage.x, damage.y, damage.width, damage.height);
+        }
+    }
+    // The pointer and key say nothing about what was saved, so hash the
+    // snapshot's generation
+    hash_draw(OP_STATIC_LAYER, (int)_generation);
+    slots[_slot].last_use = ++use_clock;
+    return true;
+}
+
+bool StaticLayer::save(int key) {
+    _valid = false;
+    if (!claim_slot()) {
+        return false;
+    }
+    memcpy(pixels(), canvas.getBuffer(), slot_bytes);
+    _key                  = key;
+    _valid                = true;
+    _generation           = next_draw_generation();
+    slots[_slot].last_use = ++use_clock;
+
+    CanvasRect damage;
+    take_canvas_damage(damage);
+    n_kept       = 0;
+    canvas_layer = this;
+    return true;
+}
+
+void static_layer_end_frame() {
+    uint8_t* snapshot = canvas_layer ? canvas_layer->pixels() : nullptr;
+    if (!snapshot) {
+        n_kept = 0;
+        return;
+    }
+    // The frame did not draw these lines, so they are stale, but the scene
+    // may have drawn something else over them, such as a message in place
+    // of the DRO; that has to stay.
+    const CanvasRect* drawn;
+    int               n_drawn = canvas_damage_rects(&drawn);
+    bool              stale[max_kept];
+    for (int i = 0; i < n_kept; i++) {
+        stale[i] = !dro_line_redrawn(kept[i]);
+        if (stale[i]) {
+            copy_rect((uint8_t*)canvas.getBuffer(), snapshot, kept[i], drawn, n_drawn);
+        }
+    }
+    // Only now, since marking adds to what drawn points at
+    for (int i = 0; i < n_kept; i++) {
+        if (stale[i]) {
+            mark_dirty(kept[i].x, kept[i].y, kept[i].width, kept[i].height);
+        }
+    }
+    n_kept = 0;
+}
+
+void static_layers_invalidate_all() {
+    for (auto& slot : slots) {
+        if (slot.owner) {
+            slot.owner->_valid = false;
+        }
+    }
+    canvas_layer = nullptr;
+}
+
+size_t static_layers_bytes() {
+    size_t bytes = 0;
+    for (auto& slot : slots) {
+        if (slot.pixels) {
+            bytes += slot_bytes;
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,89 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Cached static layers.
+//
+// Much of what a scene draws never changes between frames: the background,
+// the title, dial graphics and scroll tracks.  A scene can draw that content
+// once, save() a snapshot of the canvas, and on later frames restore() the
+// snapshot and draw only the dynamic content on top.
+//
+// A layer is identified by a key chosen by the scene, so content that
+// depends on a setting can be cached under a key that encodes it; restoring
+// with a different key fails and the scene redraws.  invalidate() drops the
+// content explicitly, and static_layers_invalidate_all() drops every layer,
+// e.g. after a layout change.  Nothing that a layer caches shows machine
+// state, and colors are fixed, so state changes need no invalidation.
+//
+// The snapshots live in a fixed set of canvas-sized slots that are
+// allocated the first time they are needed and then kept, so switching
+// scenes does not free and reallocate tens of kilobytes of heap.  A layer
+// that needs a slot when all are taken reuses the least recently used one,
+// whose layer then has to be drawn again.  If the first allocation fails,
+// or the heap is too low for it, save() fails and the scene just keeps
+// drawing directly.
+//
+// After a restore, only what has been drawn on the canvas since the
+// previous restore of the same layer is copied back and pushed, except the
+// DRO lines, whose cells stay on the canvas so they are still only redrawn
+// where they change (see drawDRONumber()).  A kept DRO line the frame does
+// not draw is restored at the end of the frame by static_layer_end_frame(),
+// apart from whatever the frame drew over it instead.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Bytes that all slots together may hold.  A 240x240 canvas takes 57600
+// bytes at 8 bits per pixel, so the ESP32 default is one shared slot.
+// Override with -D; 0 disables caching.
+#ifndef STATIC_LAYER_BUDGET
+#    ifdef ARDUINO
+#        define STATIC_LAYER_BUDGET 60000
+#    else
+#        define STATIC_LAYER_BUDGET (1024 * 1024)
+#    endif
+#endif
+
+#ifndef STATIC_LAYER_MAX_SLOTS
+#    define STATIC_LAYER_MAX_SLOTS 8
+#endif
+
+// Free heap, in bytes, that must remain in the largest block after a
+// slot is allocated, so WiFi and the JSON parser are not starved.
+#ifndef STATIC_LAYER_HEAP_RESERVE
+#    define STATIC_LAYER_HEAP_RESERVE 48000
+#endif
+
+class StaticLayer {
+private:
+    int      _slot       = -1;
+    int      _key        = 0;
+    bool     _valid      = false;
+    uint32_t _generation = 0;  // From next_draw_generation() at each save()
+
+    uint8_t* pixels();
+    bool     claim_slot();
+
+public:
+    // Copy the cached content to the canvas.  Returns false, leaving the
+    // canvas untouched, if there is no valid content for key.
+    bool restore(int key = 0);
+
+    // Snapshot the canvas as the content for key.  Returns false if
+    // there is not enough memory.
+    bool save(int key = 0);
+
+    void invalidate() { _valid = false; }
+
+    friend void static_layers_invalidate_all();
+    friend void static_layer_end_frame();
+};
+
+void static_layers_invalidate_all();
+
+// Called by refreshDisplay() before the push
+void static_layer_end_frame();
+
+// Bytes currently held by the slots
+size_t static_layers_bytes();
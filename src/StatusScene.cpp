@@ -3,6 +3,7 @@
 
 #include "Scene.h"
 #include "ConfirmScene.h"
+#include "Widget.h"
 
 extern Scene menuScene;
 
@@ -19,12 +20,34 @@ private:
 
     ovrd_display_t overd_display = FRO;
 
+    // Status reports arrive every few hundred ms, so only the widgets
+    // whose values changed are repainted; see Widget.h
+    WidgetList   _widgets;
+    TitleWidget  _title;
+    StatusWidget _status;
+    DROWidget    _dro[3] = { { 16, 68, 210, 32 }, { 16, 101, 210, 32 }, { 16, 134, 210, 32 } };
+    BarWidget    _progress { 20, 170, 192, 10 };
+    TextWidget   _footer { 120, 193, 220, 16 };
+    LegendWidget _legends;
+    bool         _redraw_all = true;
+
 public:
     StatusScene() : Scene("Status") {}
 
     void onExit() override {}
 
     void onEntry(void* arg) override {
+        _widgets.clear();
+        _widgets.add(&_title);
+        _widgets.add(&_status);
+        for (auto& dro : _dro) {
+            _widgets.add(&dro);
+        }
+        _widgets.add(&_progress);
+        _widgets.add(&_footer);
+        _widgets.add(&_legends);
+        _redraw_all = true;
+
         // Returned from ConfirmScene — execute the deferred soft reset.
         if (arg && strcmp((const char*)arg, "Confirmed") == 0) {
             dbg_printf("StatusScene: sending Ctrl-X soft reset\r\n");
@@ -143,30 +166,28 @@ public:
         }
     }
 
-    void onDROChange() { reDisplay(); }
-    void onLimitsChange() { reDisplay(); }
+    void     onDROChange(uint32_t changes) { request_redisplay(); }
+    uint32_t modelInterest() override { return MODEL_ALL & ~MODEL_PINS; }
+    bool     extrapolateDRO() override { return true; }
+    int      reportInterval() override { return REPORT_NORMAL_MS; }
+    int      redisplayInterval() override { return (state == Cycle || state == Hold) ? 50 : 100; }
+    void     onLimitsChange() { request_redisplay(); }
 
     void reDisplay() {
-        background();
-        drawMenuTitle(current_scene->name());
-        drawStatus();
+        if (_redraw_all) {
+            background();
+            _widgets.invalidate();
+            _redraw_all = false;
+        }
+        _title.set(name());
+        _status.update();
 
-        DRO dro(16, 68, 210, 32);
-        dro.draw(0, -1, true);
-        dro.draw(1, -1, true);
-        dro.draw(2, -1, true);
+        for (int axis = 0; axis < 3; axis++) {
+            _dro[axis].set(axis, -1, true);
+        }
 
-        int y = 170;
         if (state == Cycle || state == Hold) {
-            int width  = 192;
-            int height = 10;
-            if (myPercent > 0) {
-                drawRect(20, y, width, height, 5, LIGHTGREY);
-                width = (width * myPercent) / 100;
-                if (width > 0) {
-                    drawRect(20, y, width, height, 5, GREEN);
-                }
-            }
+            _progress.set(myPercent);
             // Feed override
             char legend[50];
             switch (overd_display) {
@@ -179,9 +200,10 @@ public:
                 case RT_FEED_SPEED:
                     sprintf(legend, "Fd:%d Spd:%d", myFeed, mySpeed);
             }
-            centered_text(legend, y + 23);
+            _footer.set(legend);
         } else {
-            centered_text(mode_string(), y + 23, GREEN, TINY);
+            _progress.set(0);
+            _footer.set(mode_string(), GREEN);
         }
 
         const char* encoder_button_text = "Menu";
@@ -221,7 +243,7 @@ public:
             case Idle:
                 break;
         }
-        drawButtonLegends(redLabel, grnLabel, yellowLabel);
+        _legends.set(redLabel, grnLabel, yellowLabel);
 
 #ifdef USE_WIFI
         if (round_display) {
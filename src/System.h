@@ -5,8 +5,10 @@
 
 #include "Config.h"
 #include "Encoder.h"
+#include "Clock.h"
 
-// minimum refresh rate in milliseconds - moved here for access in all builds
+// default minimum time between coalesced redraws in milliseconds, for scenes
+// that do not declare their own - moved here for access in all builds
 constexpr static const int UPDATE_RATE_MS = 30;
 
 #ifdef ARDUINO
@@ -21,7 +23,7 @@ void init_fnc_uart(int uart_num, int tx_pin, int rx_pin);
 #    include "Touch_Class.hpp"
 #    ifndef ARDUINO
 // Provide Arduino-compatible millis() free function for native (SDL) builds
-static inline uint32_t millis() { return lgfx::millis(); }
+static inline uint32_t millis() { return clock_ms(); }
 #    endif
 
 #    define WHITE TFT_WHITE
@@ -43,7 +45,7 @@ static inline uint32_t millis() { return lgfx::millis(); }
 #    include "M5Unified.h"
 #    ifndef ARDUINO
 // Provide Arduino-compatible millis() free function for native (SDL) builds
-static inline uint32_t millis() { return m5gfx::millis(); }
+static inline uint32_t millis() { return clock_ms(); }
 #    endif
 #endif  // USE_M5
 
@@ -75,6 +77,7 @@ void dbg_printf(const char* format, ...);
 
 void update_events();
 void delay_ms(uint32_t ms);
+uint32_t microseconds();
 
 void resetFlowControl();
 
@@ -86,6 +89,8 @@ void reinit_fnc_uart();
 extern bool round_display;
 
 void system_background();
+// Repaint one rectangle of the canvas with what system_background() draws there
+void system_background(int x, int y, int width, int height);
 
 bool screen_encoder(int x, int y, int& delta);
 bool screen_button_touched(bool pressed, int x, int y, int& button);
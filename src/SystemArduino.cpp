@@ -7,6 +7,12 @@
 #include "FluidNCModel.h"
 #include "NVS.h"
 #include "BootLog.h"
+#include "FncTrace.h"
+#include "LoopProfile.h"
+#include "JogLatency.h"
+#include "Metrics.h"
+#include "FncRx.h"
+#include "HeapStats.h"
 
 #include <Esp.h>  // ESP.restart()
 
@@ -38,21 +44,30 @@ static void uart_putchar_impl(uint8_t c) {
 #endif
 }
 
-static int uart_getchar_impl() {
-    char c;
-    int res = uart_read_bytes(fnc_uart_port, &c, 1, 0);
-    if (res == 1) {
-#ifdef LED_DEBUG
+// Whatever the UART driver has buffered, up to max bytes, in one read
+static size_t uart_read_span(uint8_t* buf, size_t max) {
+    size_t n = 0;
+    uart_get_buffered_data_len(fnc_uart_port, &n);
+    if (n == 0) {
+        return 0;
+    }
+    int res = uart_read_bytes(fnc_uart_port, buf, n < max ? n : max, 0);
+    if (res <= 0) {
+        return 0;
+    }
+#if defined(LED_DEBUG) || defined(ECHO_FNC_TO_DEBUG)
+    for (int i = 0; i < res; i++) {
+        uint8_t c = buf[i];
+#    ifdef LED_DEBUG
         if (c == '\r' || c == '\n') { ledcolor(0); }
         else                        { ledcolor(c & 7); }
-#endif
-        update_rx_time();
-#ifdef ECHO_FNC_TO_DEBUG
+#    endif
+#    ifdef ECHO_FNC_TO_DEBUG
         dbg_write(c);
-#endif
-        return (unsigned char)c;
+#    endif
     }
-    return -1;
+#endif
+    return res;
 }
 
 // True if the UART driver already has a received byte buffered
@@ -62,28 +77,60 @@ static bool uart_rx_waiting() {
     return n > 0;
 }
 
+static Counter uart_rx("uart.rx_bytes");
+static Counter uart_tx("uart.tx_bytes");
+
 #ifdef USE_WIFI
+static Counter telnet_rx("telnet.rx_bytes");
+static Counter telnet_tx("telnet.tx_bytes");
+static Counter espnow_rx("espnow.rx_bytes");
+static Counter espnow_tx("espnow.tx_bytes");
+
+// Every transport goes through here, so this is where FNC_TRACE records
+// what is sent; FncRx.cpp records what is received
 extern "C" void fnc_putchar(uint8_t c) {
-    if (wifi_use_uart_mode())   { uart_putchar_impl(c); return; }
-    if (wifi_use_espnow_mode()) { espnow_putchar(c);    return; }
+    trace_tx(c);
+    if (wifi_use_uart_mode())   { ++uart_tx;   uart_putchar_impl(c); return; }
+    if (wifi_use_espnow_mode()) { ++espnow_tx; espnow_putchar(c);    return; }
+    ++telnet_tx;
     ws_putchar(c);
 }
-extern "C" int fnc_getchar() {
-    if (wifi_use_uart_mode())   return uart_getchar_impl();
-    if (wifi_use_espnow_mode()) return espnow_getchar();
-    return ws_getchar();
+size_t fnc_rx_slice(const uint8_t** data) {
+    size_t   n;
+    Counter* rx;
+    if (wifi_use_uart_mode())        { n = rx_stage_slice(uart_read_span, data); rx = &uart_rx;   }
+    else if (wifi_use_espnow_mode()) { n = espnow_rx_slice(data);                rx = &espnow_rx; }
+    else                             { n = ws_rx_slice(data);                    rx = &telnet_rx; }
+    *rx += n;
+    return n;
+}
+void fnc_rx_release(size_t n) {
+    if (wifi_use_uart_mode())        { rx_stage_release(n);  }
+    else if (wifi_use_espnow_mode()) { espnow_rx_release(n); }
+    else                             { ws_rx_release(n);     }
 }
-// Whether another received byte is already buffered for the active transport
-extern "C" bool fnc_rx_waiting() {
+// Whether received bytes are already buffered for the active transport
+bool transport_rx_waiting() {
     if (wifi_use_uart_mode())   return uart_rx_waiting();
     if (wifi_use_espnow_mode()) return espnow_rx_available();
     return ws_rx_available();
 }
 #else
 // ── UART-only build ───────────────────────────────────────────────────────────
-extern "C" void fnc_putchar(uint8_t c) { uart_putchar_impl(c); }
-extern "C" bool fnc_rx_waiting()        { return uart_rx_waiting(); }
-extern "C" int  fnc_getchar()          { return uart_getchar_impl(); }
+extern "C" void fnc_putchar(uint8_t c) {
+    trace_tx(c);
+    ++uart_tx;
+    uart_putchar_impl(c);
+}
+bool   transport_rx_waiting() { return uart_rx_waiting(); }
+size_t fnc_rx_slice(const uint8_t** data) {
+    size_t n = rx_stage_slice(uart_read_span, data);
+    uart_rx += n;
+    return n;
+}
+void fnc_rx_release(size_t n) {
+    rx_stage_release(n);
+}
 #endif
 
 // poll_extra: called by fnc_poll() inside fnc_send_line()'s blocking wait loop.
@@ -105,6 +152,28 @@ extern "C" void poll_extra() {
             ESP.restart();
             while (1) {}
         }
+#    ifdef FNC_TRACE
+        if (c == 0x14) {  // CTRL-T
+            trace_save(FNC_TRACE_FILE);
+            return;
+        }
+#    endif
+#    ifdef LOOP_PROFILE
+        if (c == 0x10) {  // CTRL-P
+            loop_profile_dump();
+            return;
+        }
+#    endif
+        if (c == 0x04) {  // CTRL-D
+            metrics_dump();
+            return;
+        }
+#    ifdef JOG_LATENCY
+        if (c == 0x05) {  // CTRL-E
+            jog_latency_export();
+            return;
+        }
+#    endif
         fnc_putchar(c);  // So you can type commands to FluidNC
     }
 #endif
@@ -114,6 +183,7 @@ void drawPngFile(const char* filename, int x, int y) {
     drawPngFile(&canvas, filename, x, y);
 }
 void drawPngFile(LGFX_Sprite* sprite, const char* filename, int x, int y) {
+    HeapScope heap_scope(HEAP_PNG);
     // When datum is middle_center, the origin is the center of the canvas and the
     // +Y direction is down.
     std::string fn { "/" };
@@ -190,6 +260,10 @@ void delay_ms(uint32_t ms) {
     delay(ms);
 }
 
+uint32_t microseconds() {
+    return micros();
+}
+
 void dbg_write(uint8_t c) {
 #ifdef DEBUG_TO_USB
     if (debugPort.availableForWrite() > 1) {
@@ -12,7 +12,7 @@
 #include "Scene.h"
 #include "FluidNCModel.h"
 #include "Drawing.h"
-#include "NVS.h"
+#include "AsyncPush.h"
 #ifdef USE_WIFI
 #    include "WiFiConnection.h"
 #    include "PeerLink.h"
@@ -21,10 +21,6 @@
 #include <lgfx/v1/platforms/sdl/Panel_sdl.hpp>
 #include <SDL.h>
 
-#include <fcntl.h>
-#include <termios.h>
-#include <unistd.h>
-#include <sys/stat.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -69,9 +65,7 @@ static constexpr int btn_y0    = sprite_wh;  // 240
 
 static const int button_colors[n_buttons] = { RED, YELLOW, GREEN };
 
-int     num_layouts = 1;
-int32_t layout_num  = 0;
-Point   sprite_offset { 0, 0 };
+Point sprite_offset { 0, 0 };
 
 void set_layout(int /*n*/) {
     sprite_offset = { 0, 0 };
@@ -97,29 +91,7 @@ static const SDL_Scancode button_keys[n_buttons] = {
 };
 static bool _btn_last[n_buttons] = { false, false, false };
 
-static int serial_fd = -1;
-
-static bool open_serial(const char* portname) {
-    serial_fd = open(portname, O_RDWR | O_NOCTTY | O_NONBLOCK);
-    if (serial_fd < 0) {
-        printf("Can't open %s\n", portname);
-        return false;
-    }
-    struct termios tty;
-    tcgetattr(serial_fd, &tty);
-    cfsetispeed(&tty, B115200);
-    cfsetospeed(&tty, B115200);
-    tty.c_cflag  = (tty.c_cflag & ~CSIZE) | CS8;
-    tty.c_cflag &= ~(PARENB | CSTOPB | CRTSCTS);
-    tty.c_cflag |= CLOCAL | CREAD;
-    tty.c_iflag  = IGNBRK | IGNPAR;
-    tty.c_oflag  = 0;
-    tty.c_lflag  = 0;
-    tty.c_cc[VMIN]  = 0;
-    tty.c_cc[VTIME] = 0;
-    tcsetattr(serial_fd, TCSANOW, &tty);
-    return true;
-}
+bool open_serial(const char* portname);  // SystemSDL.cpp
 
 extern char* comname;
 
@@ -145,7 +117,10 @@ void init_system() {
 }
 
 void update_events() {
-    lgfx::Panel_sdl::loop();
+    // Closing the window, SIGINT and SIGTERM all arrive as SDL_QUIT
+    if (lgfx::Panel_sdl::loop()) {
+        exit(0);
+    }
     touch.update((uint32_t)lgfx::millis());
 #ifdef DEV_SIMULATED_CONNECT
     update_rx_time();
@@ -163,67 +138,8 @@ void update_events() {
 #endif
 }
 
-extern "C" int milliseconds() {
-    return (int)lgfx::millis();
-}
-
-void delay_ms(uint32_t ms) {
-    SDL_Delay(ms);
-}
-
-void drawPngFile(const char* filename, int x, int y) {
-    drawPngFile(&canvas, filename, x, y);
-}
-void drawPngFile(LGFX_Sprite* sprite, const char* filename, int x, int y) {
-    std::string fn("data/");
-    fn += filename;
-    sprite->drawPngFile(fn.c_str(), x, -y, 0, 0, 0, 0, 1.0f, 1.0f, datum_t::middle_center);
-}
-
-extern "C" void fnc_putchar(uint8_t c) {
-    if (serial_fd >= 0) {
-        write(serial_fd, &c, 1);
-    }
-}
-
-extern "C" int fnc_getchar() {
-    if (serial_fd < 0) {
-        return -1;
-    }
-    char c;
-    int  n = (int)read(serial_fd, &c, 1);
-    if (n > 0) {
-        update_rx_time();
-        return (unsigned char)c;
-    }
-    return -1;
-}
-
-extern "C" void poll_extra() {}
-
-extern "C" bool fnc_rx_waiting() { return false; }
-
-void resetFlowControl() {}
-void reinit_fnc_uart() {}
-
-void dbg_write(uint8_t c) {
-    putchar(c);
-}
-
-void dbg_print(const char* s) {
-    char c;
-    while ((c = *s++) != '\0') {
-        putchar(c);
-    }
-}
-
-void    ackBeep()             {}
-void    deep_sleep(int /*us*/) {}
-int16_t get_encoder()         { return _encoder_value; }
-
-bool ui_locked(bool /*redrawButtonsFlag*/) {
-    return false;
-}
+void    ackBeep()     {}
+int16_t get_encoder() { return _encoder_value; }
 
 static const char* button_pngs[n_buttons] = {
     "data/red_button.png", "data/orange_button.png", "data/green_button.png"
@@ -231,6 +147,7 @@ static const char* button_pngs[n_buttons] = {
 
 void redrawButtons() {
     bool show = !current_scene || current_scene->showButtons();
+    display_wait_idle();
     display.startWrite();
     for (int i = 0; i < n_buttons; i++) {
         int bx = i * button_w;
@@ -255,6 +172,9 @@ void base_display() {
 void system_background() {
     drawBackground(BLACK);
 }
+void system_background(int x, int y, int width, int height) {
+    canvas.fillRect(x, y, width, height, BLACK);
+}
 
 bool screen_button_touched(bool /*pressed*/, int x, int y, int& button) {
     if (y < btn_y0 || y >= btn_y0 + button_h) {
@@ -286,54 +206,6 @@ bool screen_encoder(int /*x*/, int /*y*/, int& /*delta*/) {
     return false;
 }
 
-static FILE* prefFile(const char* handle, const char* pname, const char* mode) {
-    static char fname[60];
-    snprintf(fname, sizeof(fname), "%s/%s", handle, pname);
-    return fopen(fname, mode);
-}
-
-void nvs_get_str(nvs_handle_t handle, const char* name, char* value, size_t* len) {
-    FILE* fd = prefFile(handle, name, "rb");
-    if (fd) {
-        *len = fread(value, 1, *len - 1, fd);
-        fclose(fd);
-    } else {
-        *len = 0;
-    }
-    value[*len] = '\0';
-}
-
-void nvs_set_str(nvs_handle_t handle, const char* name, const char* value) {
-    FILE* fd = prefFile(handle, name, "wb");
-    if (fd) {
-        fwrite(value, 1, strlen(value), fd);
-        fclose(fd);
-    }
-}
-
-void nvs_get_i32(nvs_handle_t handle, const char* name, int32_t* value) {
-    char   s[20];
-    size_t len = sizeof(s);
-    nvs_get_str(handle, name, s, &len);
-    if (*s) {
-        *value = atoi(s);
-    }
-}
-
-void nvs_set_i32(nvs_handle_t handle, const char* name, int32_t value) {
-    char s[20];
-    snprintf(s, sizeof(s), "%d", value);
-    nvs_set_str(handle, name, s);
-}
-
-nvs_handle_t nvs_init(const char* name) {
-    char dname[50];
-    mkdir("prefs", 0755);
-    snprintf(dname, sizeof(dname), "prefs/%s", name);
-    mkdir(dname, 0755);
-    return strdup(dname);
-}
-
 int  battery_level()           { return 75; }
 bool battery_charging()        { return true; }
 int  adc_millivolts(int pin)   { return (pin == 39) ? 2484 : 0; }
@@ -368,7 +240,8 @@ int         wifi_signal_bars()                           { return 3; }
 const char* wifi_last_error()                            { return nullptr; }
 WiFiConfig  wifi_active_config()                         { return _preview_cfg; }
 void        ws_putchar(uint8_t)                          {}
-int         ws_getchar()                                 { return -1; }
+size_t      ws_rx_slice(const uint8_t** data)            { return 0; }
+void        ws_rx_release(size_t n)                      {}
 bool          wifi_use_uart_mode()                           { return false; }
 void          wifi_set_uart_mode(bool)                       {}
 bool          wifi_is_first_boot()                           { return false; }
@@ -399,7 +272,8 @@ bool        wifi_ota_sta_connected()   { return true; }
 void        espnow_init()                                {}
 void        espnow_poll()                                {}
 void        espnow_putchar(uint8_t)                      {}
-int         espnow_getchar()                             { return -1; }
+size_t      espnow_rx_slice(const uint8_t** data)        { return 0; }
+void        espnow_rx_release(size_t n)                  {}
 bool        espnow_is_paired()                           { return true; }
 bool        espnow_is_connected()                        { return true; }
 const char* espnow_status_str()                          { return "Simulated"; }
@@ -0,0 +1,157 @@
+// 2026 - Figamore
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// System interface routines for macOS and Linux (native SDL builds).  The
+// rest of the host layer, shared with Windows, is in SystemSDL.cpp.
+//
+// With -DHEADLESS no window is opened: SDL's dummy video driver gives
+// Panel_sdl an off-screen surface, so the full scene and protocol stack runs
+// on a machine with no display, e.g. for benchmarks and replay tests.  SDL2
+// itself is still needed to build and run.
+
+#include "stdio.h"
+
+#include "System.h"
+#include "FluidNCModel.h"
+#include "M5GFX.h"
+#include "Drawing.h"
+#ifdef USE_WIFI
+#    include "WiFiConnection.h"
+#    include "PeerLink.h"
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+
+bool open_serial(const char* portname);  // SystemSDL.cpp
+
+extern char* comname;
+
+void init_system() {
+#ifdef HEADLESS
+    setenv("SDL_VIDEODRIVER", "dummy", 1);
+#endif
+    lgfx::Panel_sdl::setup();
+
+    auto cfg = M5.config();
+    M5.begin(cfg);
+
+    if (comname != NULL) {
+        if (!open_serial(comname)) {
+            printf("Running without serial connection\n");
+        }
+    } else {
+        printf("No serial port given — running in preview mode (no FluidNC connection)\n");
+    }
+
+    canvas.createSprite(display.width(), display.height());
+
+    display.clear();
+    speaker.setVolume(255);
+}
+
+// -- Battery stubs for macOS and Linux builds (M5 Dial has no battery circuitry) --
+int  battery_level()    { return -1; }
+bool battery_charging() { return false; }
+
+#ifdef USE_WIFI
+// ── WiFi stubs for macOS and Linux builds ─────────────────────────────────────
+// These let the WiFi scenes compile and render on the SDL simulator.
+// All networking is no-op; status values are fixed to show a connected state.
+
+static WiFiConfig _preview_cfg = { "Preview SSID", "", "192.168.1.100", false };
+
+void        wifi_init(bool)               {}
+void        wifi_poll()                    {}
+bool        wifi_is_connected()            { return true; }
+bool        websocket_is_connected()       { return true; }
+void        wifi_force_ws_reconnect()      {}
+void        wifi_shutdown()                {}
+bool        wifi_in_ap_mode()              { return false; }
+void        wifi_start_ap_setup()          {}
+void        wifi_stop_ap_and_restart()     {}
+void        wifi_stop_ap()                 {}
+void        wifi_save_config(const char*, const char*, const char*) {}
+WiFiConfig  wifi_load_config()             { return _preview_cfg; }
+const char* wifi_ap_ssid()                 { return "FluidDial"; }
+const char* wifi_status_str()              { return "Connected"; }
+const bool  wifi_not_ready()               { return false; }
+int         wifi_signal_bars()             { return 3; }
+const char* wifi_last_error()              { return nullptr; }
+WiFiConfig  wifi_active_config()           { return _preview_cfg; }
+void        ws_putchar(uint8_t)            {}
+size_t      ws_rx_slice(const uint8_t** data) { return 0; }
+void        ws_rx_release(size_t n)        {}
+bool          wifi_use_uart_mode()            { return false; }
+void          wifi_set_uart_mode(bool)        {}
+bool          wifi_is_first_boot()            { return false; }
+TransportMode wifi_get_transport()            { return TransportMode::ESPNOW; }
+void          wifi_set_transport(TransportMode) {}
+bool          wifi_use_espnow_mode()          { return true; }
+void          wifi_request_ota_reboot()       {}
+bool          wifi_ota_boot_requested()       { return false; }
+
+// ---- OTA stubs -----
+// Default to the STA "ready" view. Define DEV_SIMULATED_OTA_AP to preview the
+// AP-credentials view instead
+void        wifi_start_ota_server()    {}
+void        wifi_stop_ota_server()     {}
+void        wifi_ota_force_ap_setup()  {}
+int         wifi_ota_progress()        { return 0; }
+const char* wifi_ota_ip()              { return "192.168.1.100"; }
+const char* wifi_ota_error()           { return nullptr; }
+#ifdef DEV_SIMULATED_OTA_AP
+bool        wifi_ota_ap_mode()         { return true; }
+bool        wifi_ota_sta_connected()   { return false; }
+#else
+bool        wifi_ota_ap_mode()         { return false; }
+bool        wifi_ota_sta_connected()   { return true; }
+#endif
+
+// ESP-NOW stubs
+void        espnow_init()                  {}
+void        espnow_poll()                  {}
+void        espnow_putchar(uint8_t)        {}
+size_t      espnow_rx_slice(const uint8_t** data) { return 0; }
+void        espnow_rx_release(size_t n)    {}
+bool        espnow_is_paired()             { return true; }
+bool        espnow_is_connected()          { return true; }
+const char* espnow_status_str()            { return "Simulated"; }
+void        espnow_start_pairing()         {}
+void        espnow_cancel_pairing()        {}
+bool        espnow_pairing_complete()      { return false; }
+void        espnow_clear_pairing()         {}
+bool        espnow_has_saved_pairing()     { return true; }
+bool        espnow_is_reconnecting()       { return false; }
+int8_t      espnow_rssi()                  { return 0; }
+int         espnow_signal_bars()           { return 3; }
+static constexpr size_t MOCK_ESPNOW_PROFILE_COUNT = 5;
+
+size_t      espnow_profile_count()         { return MOCK_ESPNOW_PROFILE_COUNT; }
+int         espnow_active_profile_index()  { return 0; }
+bool        espnow_get_profile(size_t index, ESPNowProfileInfo& out) {
+    memset(&out, 0, sizeof(out));
+    if (index >= MOCK_ESPNOW_PROFILE_COUNT) return false;
+    static const uint8_t macs[MOCK_ESPNOW_PROFILE_COUNT][6] = {
+        {0x44, 0x1d, 0x64, 0xf2, 0x27, 0xe4},
+        {0x24, 0x6f, 0x28, 0xaa, 0xbb, 0xcc},
+        {0x94, 0xb9, 0x7e, 0x41, 0x94, 0x30},
+        {0x30, 0xae, 0xa4, 0x18, 0x52, 0x71},
+        {0x7c, 0xdf, 0xa1, 0x09, 0x63, 0xb8},
+    };
+    static const char* hostnames[MOCK_ESPNOW_PROFILE_COUNT] = {
+        "shop-mill",
+        "plotter",
+        "laser-1",
+        "plasma-cutter",
+        "garage-cnc",
+    };
+    memcpy(out.mac, macs[index], sizeof(out.mac));
+    out.channel = static_cast<uint8_t>(index + 1);
+    out.active = index == 0;
+    snprintf(out.hostname, sizeof(out.hostname), "%s", hostnames[index]);  // glibc has no strlcpy
+    return true;
+}
+bool        espnow_select_profile(size_t)  { return true; }
+bool        espnow_remove_profile(size_t)  { return true; }
+#endif  // USE_WIFI
@@ -0,0 +1,343 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// System interface routines shared by the native SDL builds - macOS and
+// Linux (SystemPosix.cpp), Windows (SystemWindows.cpp) and the macOS CYD
+// preview (SystemMacOS_CYD.cpp).  Those files hold only what differs: how
+// the display and buttons are set up and how the FluidNC port is opened.
+
+// stdio.h must precede the include of M5Unified.h in System.h
+// in order for image files to work correctly
+#include "stdio.h"
+
+#include "System.h"
+#include "Drawing.h"
+#include "NVS.h"
+#include "HeapStats.h"
+
+#include <string>
+#include <string.h>
+#include <stdlib.h>
+#include <SDL.h>
+#ifdef _WIN32
+#    include <direct.h>
+#else
+#    include "FncTrace.h"
+#    include "FncRx.h"
+#    include <fcntl.h>
+#    include <termios.h>
+#    include <unistd.h>
+#    include <sys/stat.h>
+#endif
+
+extern "C" int milliseconds() {
+    return clock_ms();
+}
+
+void delay_ms(uint32_t ms) {
+    if (clock_is_virtual()) {
+        clock_advance_ms(ms);
+        return;
+    }
+    SDL_Delay(ms);
+}
+
+uint32_t microseconds() {
+    return clock_us();
+}
+
+void drawPngFile(const char* filename, int x, int y) {
+    drawPngFile(&canvas, filename, x, y);
+}
+void drawPngFile(LGFX_Sprite* sprite, const char* filename, int x, int y) {
+    HeapScope heap_scope(HEAP_PNG);
+    std::string fn("data/");
+    fn += filename;
+    // When datum is middle_center, the origin is the center of the canvas and the
+    // +Y direction is down.
+    sprite->drawPngFile(fn.c_str(), x, -y, 0, 0, 0, 0, 1.0f, 1.0f, datum_t::middle_center);
+}
+
+int     num_layouts = 1;
+int32_t layout_num  = 0;
+
+void resetFlowControl() {}
+void reinit_fnc_uart() {}
+
+extern "C" void poll_extra() {}
+
+void deep_sleep(int us) {}
+
+bool ui_locked(bool redrawButtonsFlag) {
+    return false;
+}
+
+void dbg_write(uint8_t c) {
+    putchar(c);
+}
+
+void dbg_print(const char* s) {
+    char c;
+    while ((c = *s++) != '\0') {
+        putchar(c);
+    }
+}
+
+// Preferences are kept one file per name under prefs/<namespace>/
+static FILE* prefFile(const char* handle, const char* pname, const char* mode) {
+    static char fname[60];
+    snprintf(fname, sizeof(fname), "%s/%s", handle, pname);
+    return fopen(fname, mode);
+}
+
+void nvs_get_str(nvs_handle_t handle, const char* name, char* value, size_t* len) {
+    FILE* fd = prefFile(handle, name, "rb");
+    if (fd) {
+        *len = fread(value, 1, *len - 1, fd);
+        fclose(fd);
+    } else {
+        *len = 0;
+    }
+    value[*len] = '\0';
+}
+void nvs_set_str(nvs_handle_t handle, const char* name, const char* value) {
+    FILE* fd = prefFile(handle, name, "wb");
+    if (fd) {
+        fwrite(value, 1, strlen(value), fd);
+        fclose(fd);
+    }
+}
+
+void nvs_get_i32(nvs_handle_t handle, const char* name, int32_t* value) {
+    char   strval[20];
+    size_t len = sizeof(strval);
+    nvs_get_str(handle, name, strval, &len);
+    if (*strval) {
+        *value = atoi(strval);
+    }
+}
+void nvs_set_i32(nvs_handle_t handle, const char* name, int32_t value) {
+    char valstr[20];
+    snprintf(valstr, sizeof(valstr), "%d", value);
+    nvs_set_str(handle, name, valstr);
+}
+
+static void make_dir(const char* path) {
+#ifdef _WIN32
+    _mkdir(path);
+#else
+    mkdir(path, 0755);
+#endif
+}
+
+nvs_handle_t nvs_init(const char* name) {
+    char dname[50];
+    make_dir("prefs");
+    snprintf(dname, sizeof(dname), "prefs/%s", name);
+    make_dir(dname);
+    return strdup(dname);
+}
+
+#ifndef _WIN32
+// FluidNC on a termios serial port, or a recorded session being replayed
+
+static int serial_fd = -1;
+
+bool open_serial(const char* portname) {
+    serial_fd = open(portname, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (serial_fd < 0) {
+        printf("Can't open %s\n", portname);
+        return false;
+    }
+
+    struct termios tty;
+    tcgetattr(serial_fd, &tty);
+    cfsetispeed(&tty, B115200);
+    cfsetospeed(&tty, B115200);
+    tty.c_cflag = (tty.c_cflag & ~CSIZE) | CS8;
+    tty.c_cflag &= ~(PARENB | CSTOPB | CRTSCTS);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_iflag  = IGNBRK | IGNPAR;
+    tty.c_oflag  = 0;
+    tty.c_lflag  = 0;
+    tty.c_cc[VMIN]  = 0;
+    tty.c_cc[VTIME] = 0;
+    tcsetattr(serial_fd, TCSANOW, &tty);
+    return true;
+}
+
+extern "C" void fnc_putchar(uint8_t c) {
+    if (trace_replaying()) {
+        trace_replay_putchar(c);
+        return;
+    }
+    if (serial_fd >= 0) {
+        write(serial_fd, &c, 1);
+    }
+}
+
+static size_t serial_read_span(uint8_t* buf, size_t max) {
+    if (serial_fd < 0) {
+        return 0;
+    }
+    int cnt = (int)read(serial_fd, buf, max);
+    return cnt > 0 ? cnt : 0;
+}
+
+size_t fnc_rx_slice(const uint8_t** data) {
+    if (trace_replaying()) {
+        return trace_replay_slice(data);
+    }
+    return rx_stage_slice(serial_read_span, data);
+}
+void fnc_rx_release(size_t n) {
+    if (trace_replaying()) {
+        trace_replay_release(n);
+        return;
+    }
+    rx_stage_release(n);
+}
+
+bool transport_rx_waiting() { return trace_replaying(); }
+#endif  // !_WIN32
+
+#ifdef USE_M5
+// The round M5 Dial in a window, with PCBackground.png around it.  The
+// touch ring outside the dial stands in for the encoder and the buttons.
+
+LGFX_Device& display = M5.Display;
+LGFX_Sprite  canvas(&M5.Display);
+
+m5::Speaker_Class& speaker = M5.Speaker;
+m5::Touch_Class&   touch   = M5.Touch;
+
+bool round_display = true;
+
+Point sprite_offset { 0, 0 };
+
+// Decoded once, so that widgets can repaint pieces of it
+static LGFX_Sprite* background_sprite = nullptr;
+
+void system_background() {
+    if (!background_sprite) {
+        background_sprite = createPngBackground("PCBackground.png");
+    }
+    drawBackground(background_sprite);
+}
+void system_background(int x, int y, int width, int height) {
+    if (!background_sprite) {
+        background_sprite = createPngBackground("PCBackground.png");
+    }
+    canvas.setClipRect(x, y, width, height);
+    background_sprite->pushSprite(0, 0);
+    canvas.clearClipRect();
+}
+
+void update_events() {
+    // Closing the window, SIGINT and SIGTERM all arrive as SDL_QUIT.  Exit
+    // normally so that atexit() handlers, such as the span trace, run.
+    if (lgfx::Panel_sdl::loop()) {
+        exit(0);
+    }
+    M5.update();
+}
+
+void show_logo() {}
+void base_display() {
+    display.clear();
+}
+
+void next_layout(int delta) {}
+
+void redrawButtons() {}
+
+static bool outside_of_circle(int& x, int& y) {
+    x -= display.width() / 2;
+    y -= display.height() / 2;
+    int magsq = x * x + y * y;
+    return magsq > (120 * 120);
+}
+bool screen_encoder(int x, int y, int& delta) {
+    if (!outside_of_circle(x, y)) {
+        return false;
+    }
+    if (y >= 0) {
+        // The encoder area is the top half of the screen so
+        // if we are in the bottom half, return 0.
+        return false;
+    }
+
+    int tangent = y * 100 / x;
+    if (tangent < 0) {
+        tangent = -tangent;
+    }
+    delta = 4;
+    if (tangent > 172) {  // tan(60)*100
+        delta = 1;
+    } else if (tangent > 100) {  // tan(45)*100
+        delta = 2;
+    } else if (tangent > 58) {  // tan(30)*100
+        delta = 3;
+    }
+    if (x < 0) {
+        delta = -delta;
+    }
+    return true;
+}
+
+bool screen_button_touched(bool pressed, int x, int y, int& button) {
+    if (!outside_of_circle(x, y)) {
+        return false;
+    }
+    if (x <= -90) {
+        button = 0;
+    } else if (x >= 90) {
+        button = 2;
+    } else {
+        button = 1;
+    }
+    return true;
+}
+
+// BtnA is the red button, BtnB the dial button and BtnC the green button
+bool switch_button_touched(bool& pressed, int& button) {
+    if (M5.BtnA.wasPressed()) {
+        button  = 0;
+        pressed = true;
+        return true;
+    }
+    if (M5.BtnA.wasReleased()) {
+        button  = 0;
+        pressed = false;
+        return true;
+    }
+    if (M5.BtnB.wasPressed()) {
+        button  = 1;
+        pressed = true;
+        return true;
+    }
+    if (M5.BtnB.wasReleased()) {
+        button  = 1;
+        pressed = false;
+        return true;
+    }
+    if (M5.BtnC.wasPressed()) {
+        button  = 2;
+        pressed = true;
+        return true;
+    }
+    if (M5.BtnC.wasReleased()) {
+        button  = 2;
+        pressed = false;
+        return true;
+    }
+    return false;
+}
+
+void ackBeep() {
+    speaker.tone(1800, 50);
+}
+
+int16_t get_encoder() {
+    return 0;
+}
+#endif  // USE_M5
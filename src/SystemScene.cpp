@@ -1,5 +1,5 @@
 // 2026 - Figamore
-// SystemScene.cpp — "More" settings hub: display orientation, restart, sleep.
+// SystemScene.cpp — "More" settings hub: display orientation, restart, sleep, diagnostics.
 
 #ifdef USE_WIFI
 
@@ -13,6 +13,8 @@
 #include "System.h"
 #include "FluidNCModel.h"
 
+extern Scene diagnosticsScene;
+
 struct SysItem {
     const char* label;
     const char* sublabel;
@@ -28,6 +30,7 @@ static const SysItem items[] = {
     { "Brightness", ""     },
 #endif
     { "OTA Update", ""  },
+    { "Diagnostics", "" },
 };
 static const int N_ITEMS = (int)(sizeof(items) / sizeof(items[0]));
 
@@ -37,6 +40,22 @@ static constexpr int ITEM_H_CYD       = 40;
 static constexpr int ITEM_PITCH_CYD   = 42;
 static constexpr int START_Y_ROUND    = 38;
 static constexpr int START_Y_CYD      = 46;
+static constexpr int END_Y_ROUND      = 210;  // Above the button legends
+static constexpr int END_Y_CYD        = 232;
+
+// Items keep their full size when they fit, and shrink to fit otherwise
+static void item_geometry(int& item_h, int& item_pitch, int& start_y) {
+    int end_y  = round_display ? END_Y_ROUND : END_Y_CYD;
+    start_y    = round_display ? START_Y_ROUND : START_Y_CYD;
+    item_pitch = round_display ? ITEM_PITCH_ROUND : ITEM_PITCH_CYD;
+    item_h     = round_display ? ITEM_H_ROUND : ITEM_H_CYD;
+    if (item_pitch * N_ITEMS > end_y - start_y) {
+        item_pitch = (end_y - start_y) / N_ITEMS;
+    }
+    if (item_h > item_pitch) {
+        item_h = item_pitch;
+    }
+}
 
 int SystemScene::itemCount() { return N_ITEMS; }
 
@@ -84,6 +103,9 @@ void SystemScene::activateSelected() {
             push_scene(&otaScene);
 #endif
             break;
+        case 4:
+            push_scene(&diagnosticsScene);
+            break;
     }
 }
 
@@ -92,9 +114,8 @@ void SystemScene::onGreenButtonPress() { activateSelected(); }
 void SystemScene::onRedButtonPress()   { activate_scene(&wifiSetupScene); }
 
 void SystemScene::onTouchClick() {
-    int item_h    = round_display ? ITEM_H_ROUND    : ITEM_H_CYD;
-    int item_pitch = round_display ? ITEM_PITCH_ROUND : ITEM_PITCH_CYD;
-    int start_y   = round_display ? START_Y_ROUND   : START_Y_CYD;
+    int item_h, item_pitch, start_y;
+    item_geometry(item_h, item_pitch, start_y);
     for (int i = 0; i < N_ITEMS; i++) {
         int y = start_y + i * item_pitch;
         if (touchX >= 30 && touchX <= 210 && touchY >= y - 2 && touchY < y + item_h - 4) {
@@ -107,9 +128,8 @@ void SystemScene::onTouchClick() {
 }
 
 void SystemScene::reDisplay() {
-    int item_h     = round_display ? ITEM_H_ROUND    : ITEM_H_CYD;
-    int item_pitch = round_display ? ITEM_PITCH_ROUND : ITEM_PITCH_CYD;
-    int start_y    = round_display ? START_Y_ROUND   : START_Y_CYD;
+    int item_h, item_pitch, start_y;
+    item_geometry(item_h, item_pitch, start_y);
 
     background();
     centered_text("Settings", 16);
@@ -11,50 +11,10 @@
 #include "FluidNCModel.h"
 #include "M5GFX.h"
 #include "Drawing.h"
-#include "NVS.h"
+#include "FncRx.h"
 
 #include <windows.h>
 #include <commctrl.h>
-#include <direct.h>
-
-LGFX_Device& display = M5.Display;
-LGFX_Sprite  canvas(&M5.Display);
-
-m5::Speaker_Class& speaker     = M5.Speaker;
-m5::Touch_Class&   touch       = M5.Touch;
-m5::Button_Class&  dialButton  = M5.BtnB;
-m5::Button_Class&  greenButton = M5.BtnC;
-m5::Button_Class&  redButton   = M5.BtnA;
-
-bool round_display = true;
-
-void system_background() {
-    drawPngFile("PCBackground.png", 0, 0);
-}
-
-void update_events() {
-    lgfx::Panel_sdl::loop();
-    M5.update();
-}
-
-extern "C" int milliseconds() {
-    return m5gfx::millis();
-}
-
-void delay_ms(uint32_t ms) {
-    SDL_Delay(ms);
-}
-
-void drawPngFile(const char* filename, int x, int y) {
-    drawPngFile(&canvas, filename, x, y);
-}
-void drawPngFile(LGFX_Sprite* sprite, const char* filename, int x, int y) {
-    std::string fn("data/");
-    fn += filename;
-    // When datum is middle_center, the origin is the center of the canvas and the
-    // +Y direction is down.
-    sprite->drawPngFile(fn.c_str(), x, -y, 0, 0, 0, 0, 1.0f, 1.0f, datum_t::middle_center);
-}
 
 #define TIOCM_LE 0x001
 #define TIOCM_DTR 0x002
@@ -276,190 +236,31 @@ void init_system() {
     speaker.setVolume(255);
 }
 
-Point sprite_offset { 0, 0 };
-
-void show_logo() {}
-void base_display() {
-    display.clear();
-}
-
-void next_layout(int delta) {}
-
-void resetFlowControl() {}
-void reinit_fnc_uart() {}
-
 extern "C" void fnc_putchar(uint8_t c) {
     serial_write(hFNC, &c, 1);
 }
 
-extern "C" int fnc_getchar() {
-    char c;
-    int  cnt = serial_timed_read_com(hFNC, &c, 1, 1);
-    if (cnt > 0) {
-        update_rx_time();
-#ifdef ECHO_FNC_TO_DEBUG
-        dbg_write(c);
-#endif
-        return c;
-    }
-    return -1;
-}
-
-extern "C" void poll_extra() {}
-
-void dbg_write(uint8_t c) {
-    putchar(c);
-}
-
-void dbg_print(const char* s) {
-    char c;
-    while ((c = *s++) != '\0') {
-        putchar(c);
-    }
-}
-
-static bool outside_of_circle(int& x, int& y) {
-    x -= display.width() / 2;
-    y -= display.height() / 2;
-    int magsq = x * x + y * y;
-    return magsq > (120 * 120);
-}
-bool screen_encoder(int x, int y, int& delta) {
-    if (!outside_of_circle(x, y)) {
-        return false;
-    }
-    if (y >= 0) {
-        // The encoder area is the top half of the screen so
-        // if we are in the bottom half, return 0.
-        return false;
-    }
-
-    int tangent = y * 100 / x;
-    if (tangent < 0) {
-        tangent = -tangent;
-    }
-    delta = 4;
-    if (tangent > 172) {  // tan(60)*100
-        delta = 1;
-    } else if (tangent > 100) {  // tan(45)*100
-        delta = 2;
-    } else if (tangent > 58) {  // tan(30)*100
-        delta = 3;
-    }
-    if (x < 0) {
-        delta = -delta;
-    }
-    return true;
-}
-
-bool screen_button_touched(bool pressed, int x, int y, int& button) {
-    if (!outside_of_circle(x, y)) {
-        return false;
-    }
-    if (x <= -90) {
-        button = 0;
-    } else if (x >= 90) {
-        button = 2;
-    } else {
-        button = 1;
-    }
-    return true;
-}
-
-bool switch_button_touched(bool& pressed, int& button) {
-    if (redButton.wasPressed()) {
-        button  = 0;
-        pressed = true;
-        return true;
-    }
-    if (redButton.wasReleased()) {
-        button  = 0;
-        pressed = false;
-        return true;
-    }
-    if (dialButton.wasPressed()) {
-        button  = 1;
-        pressed = true;
-        return true;
-    }
-    if (dialButton.wasReleased()) {
-        button  = 1;
-        pressed = false;
-        return true;
-    }
-    if (greenButton.wasPressed()) {
-        button  = 2;
-        pressed = true;
-        return true;
-    }
-    if (greenButton.wasReleased()) {
-        button  = 2;
-        pressed = false;
-        return true;
-    }
-    return false;
-}
-
-void ackBeep() {
-    speaker.tone(1800, 50);
-}
-
-void deep_sleep() {}
-
-int16_t get_encoder() {
-    return 0;
-}
-
-static FILE* prefFile(const char* handle, const char* pname, const char* mode) {
-    static char fname[60];
-    snprintf(fname, 60, "%s/%s", handle, pname);
-
-    return fopen(fname, mode);
-}
-
-void nvs_get_str(nvs_handle_t handle, const char* name, char* value, size_t* len) {
-    FILE* fd = prefFile(handle, name, "rb");
-    if (fd) {
-        *len = fread(value, 1, *len - 1, fd);
-        fclose(fd);
-    } else {
-        *len = 0;
+static size_t com_read_span(uint8_t* buf, size_t max) {
+    int cnt = serial_timed_read_com(hFNC, (char*)buf, max, 1);
+    if (cnt <= 0) {
+        return 0;
     }
-    value[*len] = '\0';
-}
-void nvs_set_str(nvs_handle_t handle, const char* name, const char* value) {
-    FILE* fd = prefFile(handle, name, "wb");
-    if (fd) {
-        fwrite(value, 1, strlen(value), fd);
-        fclose(fd);
+#ifdef ECHO_FNC_TO_DEBUG
+    for (int i = 0; i < cnt; i++) {
+        dbg_write(buf[i]);
     }
+#endif
+    return cnt;
 }
 
-void nvs_get_i32(nvs_handle_t handle, const char* name, int32_t* value) {
-    char   strval[20];
-    size_t len = 20;
-    nvs_get_str(handle, name, strval, &len);
-    if (*strval) {
-        *value = atoi(strval);
-    }
-}
-void nvs_set_i32(nvs_handle_t handle, const char* name, int32_t value) {
-    char valstr[20];
-    snprintf(valstr, 20, "%d", value);
-    nvs_set_str(handle, name, valstr);
+size_t fnc_rx_slice(const uint8_t** data) {
+    return rx_stage_slice(com_read_span, data);
 }
-
-nvs_handle_t nvs_init(const char* name) {
-    char dname[50];
-    _mkdir("prefs");
-    snprintf(dname, 50, "prefs/%s", name);
-    _mkdir(dname);
-
-    return strdup(dname);
+void fnc_rx_release(size_t n) {
+    rx_stage_release(n);
 }
 
-bool ui_locked(bool redrawButtonsFlag) {
+bool transport_rx_waiting() {
     return false;
 }
 
-void redrawButtons() {}
@@ -2,7 +2,12 @@
 // Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
 
 #include "Text.h"
+#include "Drawing.h"
+#include "GlyphAtlas.h"
+#include <algorithm>
 #include <map>
+#include <cstring>
+#include <string>
 
 const GFXfont* font[] = {
     // lgfx::v1::IFont* font[] = {
@@ -13,11 +18,45 @@ const GFXfont* font[] = {
     &fonts::FreeMonoBold18pt7b,  // MEDIUM_MONO
 };
 
+// Record the canvas area covered by msg drawn at x,y with the current font.
+// The low two datum bits select left/center/right and the next three select
+// top/middle/bottom/baseline.  The box is padded to cover glyph overhang.
+static void mark_text_dirty(const char* msg, int x, int y, fontnum_t fontnum, int datum) {
+    int width  = text_width(msg, fontnum);
+    int height = canvas.fontHeight();
+    switch (datum & 3) {
+        case 1:
+            x -= width / 2;
+            break;
+        case 2:
+            x -= width;
+            break;
+    }
+    switch (datum & 0x1c) {
+        case 4:
+            y -= height / 2;
+            break;
+        case 8:
+            y -= height;
+            break;
+        case 16:
+            y -= height;
+            height += height / 2;  // descenders
+            break;
+    }
+    mark_dirty(x - 2, y - 2, width + 4, height + 4);
+}
+
 void text(const char* msg, int x, int y, int color, fontnum_t fontnum, int datum) {
     canvas.setFont(font[fontnum]);
-    canvas.setTextDatum(datum);
-    canvas.setTextColor(color);
-    canvas.drawString(msg, x, y);
+    if (!glyph_atlas_text(msg, x, y, color, fontnum, datum)) {
+        canvas.setTextDatum(datum);
+        canvas.setTextColor(color);
+        canvas.drawString(msg, x, y);
+    }
+    mark_text_dirty(msg, x, y, fontnum, datum);
+    hash_draw(OP_TEXT, x, y, color, fontnum, datum);
+    hash_draw(msg);
 }
 void text(const std::string& msg, int x, int y, int color, fontnum_t fontnum, int datum) {
     text(msg.c_str(), x, y, color, fontnum, datum);
@@ -31,113 +70,242 @@ void text(const std::string& msg, Point xy, int color, fontnum_t fontnum, int da
     text(msg.c_str(), xy, color, fontnum, datum);
 }
 
+int glyph_advance(fontnum_t fontnum, int c) {
+    const GFXfont* f = font[fontnum];
+    if (c < f->first || c > f->last) {
+        return 0;
+    }
+    return f->glyph[c - f->first].xAdvance;
+}
+
 void centered_text(const char* msg, int y, int color, fontnum_t fontnum) {
     //    text(msg, display_short_side() / 2, y, color, fontnum);
     text(msg, canvas.width() / 2, y, color, fontnum);
 }
 
-void auto_text(const std::string& txt, int x, int y, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
-    bool doesnotfit = true;
-    while (true) {  // forever loop
-        int f = fontnum;
-        if (canvas.textWidth(txt.c_str(), font[fontnum]) <= w) {
-            doesnotfit = false;
-            break;
+// Text measurement.
+//
+// Per-font advance tables make the width of a string a sum of table
+// lookups, and a small direct-mapped cache keyed by (string hash, font)
+// remembers recent results, since the same labels and filenames are
+// measured on every redraw.  Characters outside printable ASCII fall back
+// to the graphics library.
+
+static const int first_adv = ' ';
+static const int last_adv  = '~';
+static const int n_fonts   = MEDIUM_MONO + 1;
+
+// Measured the way textWidth() measures a GFXfont string: a glyph that
+// starts left of the cursor moves the whole string right, each glyph but
+// the last adds its advance, and the last adds its advance or the right
+// edge of its bitmap, whichever is further.
+struct AdvanceTable {
+    uint8_t advance[last_adv - first_adv + 1];
+    uint8_t extent[last_adv - first_adv + 1];  // max(xAdvance, xOffset + width)
+    uint8_t lead[last_adv - first_adv + 1];    // -xOffset when negative
+};
+static AdvanceTable advances[n_fonts];
+static bool         have_advances[n_fonts];
+
+static const AdvanceTable& advance_table(fontnum_t fontnum) {
+    AdvanceTable& t = advances[fontnum];
+    if (!have_advances[fontnum]) {
+        const GFXfont* f = font[fontnum];
+        for (int c = first_adv; c <= last_adv; c++) {
+            int i = c - first_adv;
+            if (c < f->first || c > f->last) {
+                t.advance[i] = t.extent[i] = t.lead[i] = 0;
+                continue;
+            }
+            const auto& g = f->glyph[c - f->first];
+            t.advance[i]  = g.xAdvance;
+            t.extent[i]   = std::max<int>(g.xAdvance, g.xOffset + g.width);
+            t.lead[i]     = g.xOffset < 0 ? -g.xOffset : 0;
         }
-        if (fontnum && tryfonts) {
-            fontnum = (fontnum_t)(--f);
-        } else {
-            break;
+        have_advances[fontnum] = true;
+    }
+    return t;
+}
+
+// Width of the first len characters of msg, or -1 if one of them
+// is not in the advance table
+static int table_width(const char* msg, int len, fontnum_t fontnum) {
+    const AdvanceTable& t     = advance_table(fontnum);
+    int                 width = 0;
+    for (int i = 0; i < len; i++) {
+        int c = msg[i];
+        if (c < first_adv || c > last_adv) {
+            return -1;
         }
+        c -= first_adv;
+        if (i == 0) {
+            width += t.lead[c];
+        }
+        width += i == len - 1 ? t.extent[c] : t.advance[c];
     }
+    return width;
+}
 
-    std::string s(txt);
+struct WidthCacheEntry {
+    uint32_t hash;
+    int16_t  width;
+    uint8_t  fontnum;
+    bool     used;
+};
+static const int       width_cache_size = 32;  // Power of 2
+static WidthCacheEntry width_cache[width_cache_size];
 
-    if (doesnotfit) {
-        int dotswidth = canvas.textWidth(" ...");
+int text_width(const char* msg, fontnum_t fontnum) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    int      len  = 0;
+    for (; msg[len]; len++) {
+        hash = (hash ^ (uint8_t)msg[len]) * 16777619u;
+    }
+    hash = (hash ^ fontnum) * 16777619u;
 
-        while (s.length() > 4) {
-            if (trimleft) {
-                s.erase(0, 1);
-            } else {
-                s.erase(s.length() - 1);
-            }
-            if (canvas.textWidth(s.c_str()) + dotswidth <= w) {
-                if (trimleft) {
-                    s.insert(0, "... ");
-                } else {
-                    s += " ...";
-                }
-                break;
-            }
+    WidthCacheEntry& entry = width_cache[hash & (width_cache_size - 1)];
+    if (entry.used && entry.hash == hash && entry.fontnum == fontnum) {
+        return entry.width;
+    }
+    int width = table_width(msg, len, fontnum);
+    if (width < 0) {
+        width = canvas.textWidth(msg, font[fontnum]);
+    }
+    entry.hash    = hash;
+    entry.width   = width;
+    entry.fontnum = fontnum;
+    entry.used    = true;
+    return width;
+}
+
+void auto_text(const char* msg, int x, int y, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
+    while (text_width(msg, fontnum) > w) {
+        if (!(fontnum && tryfonts)) {
+            break;
         }
+        fontnum = (fontnum_t)(fontnum - 1);
     }
+    int len = strlen(msg);
+    if (len <= 4 || text_width(msg, fontnum) <= w) {
+        text(msg, x, y, color, fontnum, datum);
+        return;
+    }
+
+    // Keep the longest prefix (or suffix, if trimleft) that fits along with
+    // the dots, but at least 4 characters.  The kept width grows with its
+    // length, so binary search over the widths from the advance table.
+    static const char dots[]  = " ...";
+    static const int  max_out = 120;
 
-    text(s, x, y, color, fontnum, datum);
+    int room = w - text_width(dots, fontnum);
+    int lo   = 4;  // Always kept
+    int hi   = len - 1;
+    if (hi > max_out) {
+        hi = max_out;
+    }
+    int best = 0;
+    while (lo <= hi) {
+        int         mid   = (lo + hi) / 2;
+        const char* start = trimleft ? msg + len - mid : msg;
+        int         width = table_width(start, mid, fontnum);
+        if (width < 0) {
+            char prefix[max_out + 1];
+            memcpy(prefix, start, mid);
+            prefix[mid] = '\0';
+            width       = canvas.textWidth(prefix, font[fontnum]);
+        }
+        if (width <= room) {
+            best = mid;
+            lo   = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    char out[max_out + sizeof(dots)];
+    if (best) {
+        if (trimleft) {
+            snprintf(out, sizeof(out), "... %s", msg + len - best);
+        } else {
+            snprintf(out, sizeof(out), "%.*s%s", best, msg, dots);
+        }
+    } else {
+        // Nothing fits with the dots; show the minimum without them
+        snprintf(out, sizeof(out), "%.*s", 4, trimleft ? msg + len - 4 : msg);
+    }
+    text(out, x, y, color, fontnum, datum);
 }
-void auto_text(const std::string& txt, Point xy, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
+void auto_text(const std::string& txt, int x, int y, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
+    auto_text(txt.c_str(), x, y, w, color, fontnum, datum, tryfonts, trimleft);
+}
+void auto_text(const char* txt, Point xy, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
     Point dispxy = xy.to_display();
     auto_text(txt, dispxy.x, dispxy.y, w, color, fontnum, datum, tryfonts, trimleft);
 }
+void auto_text(const std::string& txt, Point xy, int w, int color, fontnum_t fontnum, int datum, bool tryfonts, bool trimleft) {
+    auto_text(txt.c_str(), xy, w, color, fontnum, datum, tryfonts, trimleft);
+}
 
-void wrapped_text(const char* msg, int y, int w, int color, fontnum_t fontnum) {
-    canvas.setFont(font[fontnum]);
-    
-    // Count lines and find starting y position
-    std::string buffer(msg);
-    int line_count = 1;
-    std::string current_line;
-    
-    size_t pos = 0;
-    while (pos < buffer.length()) {
+// Break msg into lines no wider than w, joining the words on a line with
+// single spaces, and call draw_line(line, line_num) for each line.  A word
+// wider than w gets a line of its own.  Returns the number of lines.
+template <typename F>
+static int wrap_lines(const char* msg, int w, fontnum_t fontnum, F draw_line) {
+    // Static so that their capacity is kept from call to call
+    static std::string line;
+    static std::string test_line;
+
+    line.clear();
+    int         line_count = 0;
+    const char* pos        = msg;
+    while (*pos) {
         // Skip spaces
-        while (pos < buffer.length() && buffer[pos] == ' ') pos++;
-        if (pos >= buffer.length()) break;
-        
-        // Find next word
-        size_t word_start = pos;
-        while (pos < buffer.length() && buffer[pos] != ' ') pos++;
-        std::string word = buffer.substr(word_start, pos - word_start);
-        
-        // Test if word fits on current line
-        std::string test_line = current_line.empty() ? word : current_line + " " + word;
-        if (canvas.textWidth(test_line.c_str()) > w && !current_line.empty()) {
-            line_count++;
-            current_line = word;
-        } else {
-            current_line = test_line;
+        while (*pos == ' ') {
+            pos++;
         }
-    }
-    
-    // Draw lines
-    int line_height = 22;
-    int total_height = line_count * line_height;
-    int start_y = y - (total_height / 2);
-    int line_num = 0;
-    
-    current_line.clear();
-    pos = 0;
-    while (pos < buffer.length()) {
-        // Skip spaces
-        while (pos < buffer.length() && buffer[pos] == ' ') pos++;
-        if (pos >= buffer.length()) break;
-        
+        if (!*pos) {
+            break;
+        }
+
         // Find next word
-        size_t word_start = pos;
-        while (pos < buffer.length() && buffer[pos] != ' ') pos++;
-        std::string word = buffer.substr(word_start, pos - word_start);
-        
-        // Test if word fits on current line
-        std::string test_line = current_line.empty() ? word : current_line + " " + word;
-        if (canvas.textWidth(test_line.c_str()) > w && !current_line.empty()) {
-            centered_text(current_line.c_str(), start_y + line_num * line_height, color, fontnum);
-            line_num++;
-            current_line = word;
+        const char* word = pos;
+        while (*pos && *pos != ' ') {
+            pos++;
+        }
+
+        // Test if word fits on current line.  Candidate lines are measured
+        // directly, so they do not push real labels out of the width cache.
+        test_line = line;
+        if (!test_line.empty()) {
+            test_line += ' ';
+        }
+        test_line.append(word, pos - word);
+        int width = table_width(test_line.c_str(), test_line.length(), fontnum);
+        if (width < 0) {
+            width = canvas.textWidth(test_line.c_str(), font[fontnum]);
+        }
+        if (width > w && !line.empty()) {
+            draw_line(line.c_str(), line_count++);
+            line.assign(word, pos - word);
         } else {
-            current_line = test_line;
+            line.swap(test_line);
         }
     }
-    if (!current_line.empty()) {
-        centered_text(current_line.c_str(), start_y + line_num * line_height, color, fontnum);
+    if (!line.empty()) {
+        draw_line(line.c_str(), line_count++);
     }
+    return line_count;
+}
+
+void wrapped_text(const char* msg, int y, int w, int color, fontnum_t fontnum) {
+    // Count the lines first, to center them as a block on y
+    int line_count = wrap_lines(msg, w, fontnum, [](const char*, int) {});
+
+    // Draw lines
+    int line_height  = 22;
+    int total_height = (line_count ? line_count : 1) * line_height;
+    int start_y      = y - (total_height / 2);
+    wrap_lines(msg, w, fontnum, [&](const char* line, int line_num) {
+        centered_text(line, start_y + line_num * line_height, color, fontnum);
+    });
 }
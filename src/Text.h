@@ -15,7 +15,25 @@ enum fontnum_t {
     MEDIUM_MONO = 4,
 };
 
+extern const GFXfont* font[];
+
+// How far drawing c moves the cursor, from the font's glyph metrics.  For
+// a glyph that overhangs its advance this is less than textWidth() of c.
+int glyph_advance(fontnum_t fontnum, int c);
+
+// Width of msg in pixels, from cached per-font advance tables
+int text_width(const char* msg, fontnum_t fontnum = TINY);
+
 // adjusts text to fit in (w) display area. reduces font size until it. tryfonts::false just uses fontnum
+void auto_text(const char* txt,
+               int         x,
+               int         y,
+               int         w,
+               int         color,
+               fontnum_t   fontnum  = MEDIUM,
+               int         datum    = middle_center,
+               bool        tryfonts = true,
+               bool        trimleft = false);
 void auto_text(const std::string& txt,
                int                x,
                int                y,
@@ -26,6 +44,14 @@ void auto_text(const std::string& txt,
                bool               tryfonts = true,
                bool               trimleft = false);
 
+void auto_text(const char* txt,
+               Point       xy,
+               int         w,
+               int         color,
+               fontnum_t   fontnum  = MEDIUM,
+               int         datum    = middle_center,
+               bool        tryfonts = true,
+               bool        trimleft = false);
 void auto_text(const std::string& txt,
                Point              xy,
                int                w,
@@ -16,6 +16,8 @@
 #include "FileParser.h"  // json_reset_depth()
 #include "System.h"
 #include "Scene.h"   // request_redisplay()
+#include "Metrics.h"
+#include "FncRx.h"  // strip_cr()
 
 #include <Esp.h>
 #include <esp_attr.h>     // RTC_NOINIT_ATTR - survives soft reboot, cleared on power loss
@@ -89,7 +91,7 @@ static uint32_t         _wifi_connect_start_ms    = 0;        // millis() when W
 static uint8_t          _handshake_timeout_count  = 0;        // consecutive 4-way handshake timeouts; real auth fail after threshold
 
 // Ring buffer for characters received from FluidNC over Telnet.
-// Refilled by tcp_refill_rx() from wifi_poll(); read by fnc_getchar().
+// Refilled by tcp_refill_rx() from wifi_poll(); read in place by fnc_getchar().
 static uint8_t _rx_buf[RX_BUF_SIZE];
 static int     _rx_head = 0;
 static int     _rx_tail = 0;
@@ -177,9 +179,7 @@ static void start_dns_resolve() {
     }
 }
 
-// Ring buffer push/pop are defined further down; forward-declare so
-// tcp_refill_rx() can push received bytes from up here.
-static inline void rx_push(uint8_t c);
+static Counter tx_dropped("telnet.tx_dropped");
 
 static void tcp_close() {
     if (_sock >= 0) {
@@ -359,6 +359,7 @@ static bool tcp_send_all(const uint8_t* payload, size_t length, int flags) {
         if (n <= 0) {
             int e = errno;
             if (e == EAGAIN || e == EWOULDBLOCK) {
+                tx_dropped += length - off;
                 dbg_printf("Telnet: send EAGAIN dropped=%u of %u\n",
                            (unsigned)(length - off), (unsigned)length);
                 return true;
@@ -396,18 +397,21 @@ static void tcp_refill_rx() {
     if (_sock < 0) {
         return;
     }
-    uint8_t buf[256];
     while (true) {
-        // Compute headroom in the ring buffer (leave one slot empty to
-        // distinguish full from empty). If we'd overrun, stop and let
-        // fnc_poll drain some bytes first.
-        int used = (_rx_head - _rx_tail + RX_BUF_SIZE) % RX_BUF_SIZE;
-        int free = RX_BUF_SIZE - used - 1;
-        if (free <= 0) {
+        // Receive straight into the contiguous free space at the head of the
+        // ring (leave one slot empty to distinguish full from empty). If
+        // there is none, stop and let fnc_poll drain some bytes first.
+        int end;
+        if (_rx_tail > _rx_head) {
+            end = _rx_tail - 1;
+        } else {
+            end = _rx_tail == 0 ? RX_BUF_SIZE - 1 : RX_BUF_SIZE;
+        }
+        size_t want = end - _rx_head;
+        if (want == 0) {
             return;
         }
-        size_t want = (size_t)free < sizeof(buf) ? (size_t)free : sizeof(buf);
-        ssize_t n = ::recv(_sock, buf, want, MSG_DONTWAIT);
+        ssize_t n = ::recv(_sock, &_rx_buf[_rx_head], want, MSG_DONTWAIT);
         if (n <= 0) {
             if (n == 0) {
                 dbg_println("Telnet: peer closed");
@@ -420,11 +424,8 @@ static void tcp_refill_rx() {
             }
             return;
         }
-        for (ssize_t i = 0; i < n; i++) {
-            uint8_t c = buf[i];
-            if (c == '\r') continue;  // strip CR; GrblParserC wants LF-terminated lines
-            rx_push(c);
-        }
+        size_t kept = strip_cr(&_rx_buf[_rx_head], n);
+        _rx_head    = (_rx_head + kept) % RX_BUF_SIZE;
         update_rx_time();
         _last_rx_ms = millis();
         if ((size_t)n < want) {
@@ -434,23 +435,6 @@ static void tcp_refill_rx() {
     }
 }
 
-// ─── Ring-buffer helpers ──────────────────────────────────────────────────────
-
-static inline void rx_push(uint8_t c) {
-    int next = (_rx_head + 1) % RX_BUF_SIZE;
-    if (next != _rx_tail) {         // Drop on overflow
-        _rx_buf[_rx_head] = c;
-        _rx_head          = next;
-    }
-}
-
-static inline int rx_pop() {
-    if (_rx_head == _rx_tail) return -1;
-    uint8_t c = _rx_buf[_rx_tail];
-    _rx_tail  = (_rx_tail + 1) % RX_BUF_SIZE;
-    return (unsigned char)c;
-}
-
 // ─── Telnet transport primitives ─────────────────────────────────────────────
 // These are called by fnc_putchar/fnc_getchar (defined in SystemArduino.cpp)
 // when the active transport is WiFi. Kept under the ws_* spelling so the
@@ -485,9 +469,16 @@ void ws_putchar(uint8_t c) {
     }
 }
 
-// Receive one byte from the RX ring buffer (-1 if empty).
-int ws_getchar() {
-    return rx_pop();
+// The oldest received bytes that are contiguous in the RX ring, read in
+// place; the wrapped remainder is the next slice.
+size_t ws_rx_slice(const uint8_t** data) {
+    int end = _rx_head >= _rx_tail ? _rx_head : RX_BUF_SIZE;
+    *data   = &_rx_buf[_rx_tail];
+    return end - _rx_tail;
+}
+
+void ws_rx_release(size_t n) {
+    _rx_tail = (_rx_tail + n) % RX_BUF_SIZE;
 }
 
 bool ws_rx_available() {
@@ -1792,12 +1783,22 @@ void wifi_poll() {
         return;
     }
 
-    // Explicit status poll every 500 ms.
-    // (FluidNC auto-report via $RI is also set when state transitions from
-    // Disconnected in show_state(), but we poll here as a belt-and-suspenders
-    // measure until the first status arrives.)
-    uint32_t now = millis();
-    if (now - _last_status_ms >= STATUS_POLL_MS) {
+    // Poll for status every 500 ms until service_report_interval() has set
+    // up auto-reports with $RI.  FluidNC only auto-reports when something
+    // changes, so after that poll only when the link has been quiet for a
+    // report interval - often enough to stay clear of WIFI_RX_STALL_MS
+    // with an idle machine, without doubling the traffic of a moving one.
+    uint32_t now     = millis();
+    uint32_t poll_ms = STATUS_POLL_MS;
+    if (report_interval_ms()) {
+        if ((uint32_t)report_interval_ms() > poll_ms) {
+            poll_ms = report_interval_ms();
+        }
+        if (now - _last_rx_ms < poll_ms) {
+            return;
+        }
+    }
+    if (now - _last_status_ms >= poll_ms) {
         _last_status_ms = now;
         uint8_t qmark = '?';
         ws_send_bin(&qmark, 1);
@@ -66,8 +66,10 @@ WiFiConfig wifi_active_config();
 // ── WebSocket transport primitives (used by fnc_putchar/fnc_getchar routing) ──
 // Send one byte to FluidNC via WebSocket.
 void ws_putchar(uint8_t c);
-// Receive one byte from the WebSocket ring buffer (-1 if empty).
-int  ws_getchar();
+// The oldest received bytes that are contiguous in the ring buffer, read in
+// place until ws_rx_release() (see FncRx.h); returns the count.
+size_t ws_rx_slice(const uint8_t** data);
+void   ws_rx_release(size_t n);
 // True if a received byte is already buffered (no socket read needed).
 bool ws_rx_available();
 
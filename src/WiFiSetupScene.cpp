@@ -40,7 +40,7 @@ static void drawCardAuto(int y, const char* label, const char* value, int val_co
     int mid = y + CH / 2 + 2;
     text(label, CX + CI, mid, DARKGREY, TINY, middle_left);
     static constexpr int VALUE_W = 130;
-    auto_text(std::string(value), CX + CW - CI, mid, VALUE_W, val_color, SMALL, middle_right);
+    auto_text(value, CX + CW - CI, mid, VALUE_W, val_color, SMALL, middle_right);
 }
 
 // ─── Helpers ──────────────────────────────────────────────────────────────────
@@ -245,7 +245,7 @@ void WiFiSetupScene::drawSettingsView() {
             int active_profile = espnow_active_profile_index();
             if (active_profile >= 0 && espnow_get_profile((size_t)active_profile, profile)) {
                 const char* name = profile.hostname[0] ? profile.hostname : "Selected Machine";
-                auto_text(std::string(name), display.width() / 2, y, round_display ? 150 : 190, WHITE, SMALL);
+                auto_text(name, display.width() / 2, y, round_display ? 150 : 190, WHITE, SMALL);
                 y += (round_display ? 18 : 22);
             } else {
                 y += (round_display ? 14 : 20);
@@ -0,0 +1,169 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Widget.h"
+#include <cstring>
+
+// Copy src into a fixed buffer; returns true if the contents changed
+static bool update_string(char* dst, const char* src, size_t len) {
+    if (strncmp(dst, src, len - 1) == 0) {
+        return false;
+    }
+    strncpy(dst, src, len - 1);
+    dst[len - 1] = '\0';
+    return true;
+}
+
+void Widget::clear() {
+    drawBackground(_x, _y, _width, _height);
+}
+
+TextWidget::TextWidget(int x, int y, int width, int height, fontnum_t font, int datum) :
+    Widget(x, y, width, height), _font(font), _datum(datum), _text_x(x), _text_y(y) {
+    // Turn the text anchor point into the top left corner of the rectangle
+    switch (datum & 3) {
+        case 1:
+            _x -= width / 2;
+            break;
+        case 2:
+            _x -= width;
+            break;
+    }
+    switch (datum & 0x1c) {
+        case 4:
+            _y -= height / 2;
+            break;
+        case 8:
+        case 16:
+            _y -= height;
+            break;
+    }
+}
+
+void TextWidget::set(const char* str, int color) {
+    bool changed = update_string(_text, str, max_text);
+    if (_valid && !changed && color == _color) {
+        return;
+    }
+    _color = color;
+    clear();
+    text(_text, _text_x, _text_y, _color, _font, _datum);
+    _valid = true;
+}
+
+void LegendWidget::set(const char* red, const char* green, const char* orange) {
+    bool changed = update_string(_red, red, max_legend);
+    changed      = update_string(_green, green, max_legend) || changed;
+    changed      = update_string(_orange, orange, max_legend) || changed;
+    if (_valid && !changed) {
+        return;
+    }
+    clear();
+    drawButtonLegends(_red, _green, _orange);
+    _valid = true;
+}
+
+void StatusWidget::update() {
+    // The disconnected display animates, so its frame is part of the value
+    int  phase   = state == Disconnected ? (millis() / 400) % 4 : 0;
+    bool changed = state != _state || lastAlarm != _alarm || phase != _phase;
+    changed      = update_string(_state_string, my_state_string, sizeof(_state_string)) || changed;
+    if (_valid && !changed) {
+        return;
+    }
+    _state = state;
+    _alarm = lastAlarm;
+    _phase = phase;
+    clear();
+    drawStatus();
+    _valid = true;
+}
+
+bool DROWidget::changed(int axis, int hl_digit, bool highlight, bool homing, bool homed) {
+    int   digits = num_digits();
+    bool  limit  = myLimitSwitches[axis];
+    pos_t pos    = dro_axis(axis);
+    if (_valid && pos == _pos && hl_digit == _hl_digit && digits == _digits && highlight == _highlight && homing == _homing &&
+        homed == _homed && limit == _limit) {
+        return false;
+    }
+    _pos       = pos;
+    _hl_digit  = hl_digit;
+    _digits    = digits;
+    _highlight = highlight;
+    _homing    = homing;
+    _homed     = homed;
+    _limit     = limit;
+    return true;
+}
+
+void DROWidget::set(int axis, int hl_digit, bool highlight) {
+    if (!changed(axis, hl_digit, highlight, false, false)) {
+        return;
+    }
+    // No clear(); the DRO renderer repaints only the cells that changed
+    DRO dro(_x, _y, _width, _height);
+    dro.draw(axis, hl_digit, highlight);
+    _valid = true;
+}
+
+void DROWidget::setHoming(int axis, bool highlight, bool homed) {
+    if (!changed(axis, -1, highlight, true, homed)) {
+        return;
+    }
+    DRO dro(_x, _y, _width, _height);
+    dro.drawHoming(axis, highlight, homed);
+    _valid = true;
+}
+
+void BarWidget::set(int percent) {
+    if (_valid && percent == _percent) {
+        return;
+    }
+    _percent = percent;
+    clear();
+    if (percent > 0) {
+        drawRect(_x, _y, _width, _height, _height / 2, LIGHTGREY);
+        int width = (_width * percent) / 100;
+        if (width > 0) {
+            drawRect(_x, _y, width, _height, _height / 2, GREEN);
+        }
+    }
+    _valid = true;
+}
+
+void StripeWidget::set(const char* left, const char* right, bool highlight, int left_color) {
+    bool changed = update_string(_left, left, max_text);
+    changed      = update_string(_right, right, max_text) || changed;
+    if (_valid && !changed && highlight == _highlight && left_color == _left_color) {
+        return;
+    }
+    _highlight  = highlight;
+    _left_color = left_color;
+    clear();
+    Stripe stripe(_x, _y, _width, _height, _font);
+    stripe.draw(_left, _right, _highlight, _left_color);
+    _valid = true;
+}
+
+void LEDWidget::set(bool on) {
+    if (_valid && on == _on) {
+        return;
+    }
+    _on = on;
+    clear();
+    LED led(_x + _radius, _y + _radius, _radius, 0);
+    led.draw(_on);
+    _valid = true;
+}
+
+void WidgetList::add(Widget* widget) {
+    if (_count < max_widgets) {
+        _widgets[_count++] = widget;
+    }
+}
+
+void WidgetList::invalidate() {
+    for (int i = 0; i < _count; i++) {
+        _widgets[i]->invalidate();
+    }
+}
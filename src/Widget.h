@@ -0,0 +1,162 @@
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Retained-mode widgets built on the primitives in Drawing.h.
+//
+// A widget owns a fixed rectangle of the canvas and remembers the value it
+// last drew there.  Setting a new value repaints the widget only if the
+// value differs; the background is repainted under the rectangle first,
+// so the rest of the screen does not have to be redrawn.  A scene declares
+// its widgets in onEntry() and calls WidgetList::invalidate() whenever it
+// redraws the background, which forces every widget to repaint once.
+
+#pragma once
+
+#include "Drawing.h"
+
+class Widget {
+protected:
+    int  _x;
+    int  _y;
+    int  _width;
+    int  _height;
+    bool _valid = false;
+
+    // Repaint the background under the widget rectangle
+    void clear();
+
+public:
+    Widget(int x, int y, int width, int height) : _x(x), _y(y), _width(width), _height(height) {}
+
+    void invalidate() { _valid = false; }
+    bool valid() { return _valid; }
+};
+
+// A single line of text.  x is the anchor point for the datum, so the
+// rectangle is computed from the datum and the given width and height.
+class TextWidget : public Widget {
+private:
+    static const int max_text = 64;
+
+    char      _text[max_text] = "";
+    int       _color          = 0;
+    fontnum_t _font;
+    int       _datum;
+    int       _text_x;
+    int       _text_y;
+
+public:
+    TextWidget(int x, int y, int width, int height, fontnum_t font = TINY, int datum = middle_center);
+
+    void set(const char* str, int color = WHITE);
+};
+
+// The scene name at the top of the screen, as drawn by drawMenuTitle()
+class TitleWidget : public TextWidget {
+public:
+    TitleWidget() : TextWidget(120, 12, 200, 22) {}
+};
+
+// The three button legends, as drawn by drawButtonLegends()
+class LegendWidget : public Widget {
+private:
+    static const int max_legend = 16;
+
+    char _red[max_legend]    = "";
+    char _green[max_legend]  = "";
+    char _orange[max_legend] = "";
+
+public:
+    LegendWidget() : Widget(0, 202, 240, 38) {}
+
+    void set(const char* red, const char* green, const char* orange);
+};
+
+// The machine state box, as drawn by drawStatus()
+class StatusWidget : public Widget {
+private:
+    state_t _state = Disconnected;
+    char    _state_string[32] = "";
+    int     _alarm = 0;
+    int     _phase = 0;  // Animation frame of the disconnected display
+
+public:
+    StatusWidget() : Widget(40, 24, 160, 40) {}
+
+    void update();
+};
+
+// One axis line of the digital readout, as drawn by DRO::draw()
+// or DRO::drawHoming()
+class DROWidget : public Widget {
+private:
+    pos_t _pos       = 0;
+    int   _hl_digit  = -1;
+    int   _digits    = 0;
+    bool  _highlight = false;
+    bool  _homing    = false;
+    bool  _homed     = false;
+    bool  _limit     = false;
+
+    bool changed(int axis, int hl_digit, bool highlight, bool homing, bool homed);
+
+public:
+    DROWidget(int x, int y, int width, int height) : Widget(x, y, width, height) {}
+
+    void set(int axis, int hl_digit, bool highlight);
+    void setHoming(int axis, bool highlight, bool homed);
+};
+
+// A round-ended progress bar, as drawn by StatusScene
+class BarWidget : public Widget {
+private:
+    int _percent = -1;
+
+public:
+    BarWidget(int x, int y, int width, int height) : Widget(x, y, width, height) {}
+
+    void set(int percent);
+};
+
+// One row of a Stripe list, as drawn by Stripe::draw() or by
+// DRO::draw(axis, highlight)
+class StripeWidget : public Widget {
+private:
+    static const int max_text = 24;
+
+    char      _left[max_text]  = "";
+    char      _right[max_text] = "";
+    bool      _highlight       = false;
+    int       _left_color      = WHITE;
+    fontnum_t _font;
+
+public:
+    StripeWidget(int x, int y, int width, int height, fontnum_t font = TINY) : Widget(x, y, width, height), _font(font) {}
+
+    void set(const char* left, const char* right, bool highlight, int left_color = WHITE);
+};
+
+// An indicator light, as drawn by LED::draw()
+class LEDWidget : public Widget {
+private:
+    int  _radius;
+    bool _on = false;
+
+public:
+    LEDWidget(int x, int y, int radius) : Widget(x - radius, y - radius, 2 * radius + 1, 2 * radius + 1), _radius(radius) {}
+
+    void set(bool on);
+};
+
+// The widgets belonging to a scene, so they can be invalidated together
+class WidgetList {
+private:
+    static const int max_widgets = 16;
+
+    Widget* _widgets[max_widgets];
+    int     _count = 0;
+
+public:
+    void clear() { _count = 0; }
+    void add(Widget* widget);
+    void invalidate();
+};
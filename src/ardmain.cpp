@@ -6,9 +6,16 @@
 #include "FluidNCModel.h"  // pendant_wait_for_fluidnc_ready()
 #include "Scene.h"
 #include "AboutScene.h"
+#include "LoopProfile.h"
+#include "SpanTrace.h"
+#include "HeapStats.h"
+#include "FncRx.h"
 #if defined(USE_M5) || defined(USE_LOVYANGFX)
 #    include "BrightnessScene.h"
 #endif
+#ifdef GLYPH_ATLAS_BENCH
+#    include "GlyphAtlas.h"
+#endif
 
 #ifdef USE_WIFI
 #    include "WiFiConnection.h"
@@ -56,6 +63,10 @@ void first_boot_complete() {
 void setup() {
     init_system();
 
+#ifdef GLYPH_ATLAS_BENCH
+    glyph_atlas_benchmark();
+#endif
+
 #if defined(USE_M5) || defined(USE_LOVYANGFX)
     display.setBrightness(brightnessScene.getBrightness());
 #else
@@ -138,6 +149,9 @@ void loop() {
         service_redisplay();
         return;
     }
+#endif
+    loop_profile_begin();
+#ifdef USE_WIFI
     if (!_first_boot_active) {
         if (!_wifi_initialized) {
             // Defer transport init until after setup() returned + 1st render is
@@ -149,6 +163,7 @@ void loop() {
                 wifi_init();
             }
         }
+        TRACE_SPAN_OVER("transport_poll", 100);
         if (wifi_use_espnow_mode()) {
             espnow_poll();
         } else {
@@ -156,20 +171,30 @@ void loop() {
         }
     }
 #endif
-    // fnc_poll() drains ONE byte per call. The WiFi transport can refill its
-    // ring buffer with hundreds of bytes per loop iteration (a kernel TCP
-    // window worth — preferences.json bursts in ~5 KB). Drain a chunk per
-    // tick so the ring buffer can't overflow and silently drop bytes,
-    // which corrupts the streaming JSON parser mid-document.
-    //
-    // Drain all pending data, but stop when RX is empty to avoid 
-    // unnecessary Wi-Fi polling and reduce idle-loop jitter that can make small jog movements choppy.
-    for (int i = 0; i < 64; i++) {
-        fnc_poll();
-        if (!fnc_rx_waiting()) {
-            break;
+    loop_profile_mark(PHASE_TRANSPORT);
+
+    // Feed the parser whatever has arrived, up to FNC_RX_DRAIN bytes.  Each
+    // fnc_poll() is one parser step on one byte, which fnc_getchar() reads in
+    // place from the transport's current slice (see FncRx.h); the transport
+    // is only asked for a new slice when that one has all been read.  The
+    // WiFi transport can take in hundreds of bytes per loop iteration
+    // (preferences.json arrives in bursts of ~5 KB), so the bound is large
+    // enough to keep its ring from overflowing, and the loop stops as soon
+    // as nothing is waiting, so an idle link adds no jitter to jogging.
+    {
+        TRACE_SPAN_OVER("fnc_poll", 20);
+        for (int i = 0; i < FNC_RX_DRAIN; i++) {
+            fnc_poll();
+            if (!fnc_rx_waiting()) {
+                break;
+            }
         }
     }
+    loop_profile_mark(PHASE_FNC_POLL);
     dispatch_events();  // Handle dial, touch, buttons
+    loop_profile_mark(PHASE_DISPATCH);
     service_redisplay();
+    loop_profile_mark(PHASE_REDISPLAY);
+    loop_profile_end();
+    heap_poll();
 }
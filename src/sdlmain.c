@@ -5,6 +5,14 @@
 extern void setup();
 extern void loop();
 
+#ifdef SCENE_BENCH
+#    include "SceneBench.h"
+#endif
+#ifdef FNC_TRACE
+#    include "FncTrace.h"
+#    include <string.h>
+#endif
+
 char* comname;
 int   main(int argc, char** argv) {
 #ifdef WINDOWS
@@ -17,8 +25,21 @@ int   main(int argc, char** argv) {
     comname = (argc >= 2) ? argv[1] : NULL;
 #endif
 
+#ifdef FNC_TRACE
+    // Usage: program --replay trace.bin
+    if (argc == 3 && strcmp(argv[1], "--replay") == 0) {
+        comname = NULL;
+        setup();
+        return trace_replay(argv[2]);
+    }
+#endif
+
     setup();
 
+#ifdef SCENE_BENCH
+    return scene_bench();
+#endif
+
     while (1) {
         loop();
     }
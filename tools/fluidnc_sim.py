@@ -0,0 +1,662 @@
+#!/usr/bin/env python3
+# Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+"""FluidNC stand-in for end-to-end testing of the pendant without a controller.
+
+Serves the FluidNC protocol on a Telnet port (the pendant's WiFi transport,
+which always connects to port 23) and on a pseudo-terminal (the serial fd that
+the host builds open), so the whole stack - transports, GrblParser, the file
+and macro JSON receivers and the scenes - can be exercised against a machine
+that behaves like the real thing:
+
+  - '?' and $RI=<ms> auto-reports answer with FluidNC-style status reports,
+    with WCO and Ov fields every few reports like the firmware sends them
+  - lines are acknowledged with ok or error:N; jogs and program moves are
+    queued in a small planner, and the ok is held back while it is full
+  - $J= jogs and JogCancel (0x85) run on a simple motion model with
+    acceleration, so cancels decelerate instead of stopping dead
+  - feed hold, cycle start, reset, overrides, $X, $H, $A, $G, $I, homing
+    config queries, $SD/Run and $Localfs/Run
+  - $Files/ListGCode, $File/ShowSome and $File/SendJSON, served from a
+    directory (--sd, --localfs) or from a few built-in files; array elements
+    go on separate lines, the way large FluidNC documents arrive
+
+Fault injection for load tests: --latency delays every response, --drop-every
+closes Telnet sessions periodically to exercise reconnects, and --error-rate
+answers a fraction of lines with error:N.  Link statistics are printed every
+--stats seconds and on exit.
+
+Usage:
+    tools/fluidnc_sim.py --port 2323 --pty-link /tmp/fluidnc
+    .pio/build/linux/program /tmp/fluidnc
+
+Port 23 needs root on Linux; use --port and a redirect for the pendant, or
+point a host build at the pty.  Standard library only.
+"""
+
+import argparse
+import json
+import math
+import os
+import pty
+import random
+import re
+import selectors
+import signal
+import socket
+import sys
+import time
+import tty
+
+AXES = "XYZ"
+PLANNER_BLOCKS = 16
+EOL = "\r\n"
+
+JOG_CANCEL = 0x85
+RESET = 0x18
+
+DEFAULT_SD = {
+    "bracket.nc": "G21 G90 G94\nG0 Z5.000\nG0 X0.000 Y0.000\nM3 S12000\n"
+    + "".join("G1 Z-%.3f F300\nG1 X40.000 F1200\nG1 Y25.000\nG1 X0.000\nG1 Y0.000\n" % (0.5 * (i + 1)) for i in range(8))
+    + "G0 Z5.000\nM5\n",
+    "logo_engrave.nc": "G21 G90\nG0 Z2\n" + "".join("G1 X%.3f Y%.3f F800\n" % (20 + 15 * math.cos(a / 10.0), 20 + 15 * math.sin(a / 10.0)) for a in range(64)) + "G0 Z5\n",
+    "spoilboard_surface.nc": "G21 G90\nG0 Z5\nM3 S18000\n" + "".join("G1 X300 Y%d F3000\nG1 X0 Y%d\n" % (y, y + 10) for y in range(0, 200, 20)) + "M5\n",
+}
+
+DEFAULT_LOCALFS = {
+    "macrocfg.json": json.dumps(
+        [
+            {"name": "Park", "glyph": "", "filename": "/park.nc", "target": "ESP", "class": "", "index": 0},
+            {"name": "Probe Z", "glyph": "", "filename": "/probe_z.nc", "target": "ESP", "class": "", "index": 1},
+            {"name": "Spindle Warmup", "glyph": "", "filename": "warmup.nc", "target": "SD", "class": "", "index": 2},
+        ]
+    ),
+    "park.nc": "G53 G0 Z-1\nG53 G0 X-5 Y-5\n",
+    "probe_z.nc": "G38.2 Z-20 F100\nG91 G0 Z2\nG90\n",
+}
+
+
+class FileStore:
+    """A FluidNC filesystem: a real directory, or a dict of built-in files."""
+
+    def __init__(self, root, builtin):
+        self.root = root
+        self.builtin = builtin
+
+    def _path(self, name):
+        return os.path.join(self.root, name.strip("/"))
+
+    def listing(self, subdir):
+        if self.root is None:
+            return [(name, len(text)) for name, text in sorted(self.builtin.items())] if not subdir else None
+        path = self._path(subdir)
+        if not os.path.isdir(path):
+            return None
+        entries = []
+        for name in sorted(os.listdir(path)):
+            full = os.path.join(path, name)
+            entries.append((name, -1 if os.path.isdir(full) else os.path.getsize(full)))
+        return entries
+
+    def read(self, name):
+        if self.root is None:
+            return self.builtin.get(name.strip("/"))
+        try:
+            with open(self._path(name), errors="replace") as f:
+                return f.read()
+        except OSError:
+            return None
+
+
+def split_fs(path, default="sd"):
+    """Map /sd/x or /localfs/x to (filesystem, relative name); other paths are on the default one."""
+    for prefix in ("/sd", "/localfs"):
+        if path == prefix or path.startswith(prefix + "/"):
+            return prefix[1:], path[len(prefix) :].strip("/")
+    return default, path.strip("/")
+
+
+class Machine:
+    """Machine state and a constant-acceleration motion model shared by all sessions."""
+
+    def __init__(self, args):
+        self.accel = args.accel
+        self.state = "Alarm" if args.alarm else "Idle"
+        self.alarm = 14 if args.alarm else 0
+        self.mpos = [0.0] * len(AXES)
+        self.wco = [0.0] * len(AXES)
+        self.speed = 0.0  # mm/s along the current segment
+        self.segments = []  # [target, feed mm/min]
+        self.feed_ovr = 100
+        self.rapid_ovr = 100
+        self.spindle_ovr = 100
+        self.spindle = 0
+        self.program = None  # [name, lines, next line]
+        self.lines_per_sec = args.run_lps
+        self.line_credit = 0.0
+        self.holding = False
+
+    def planner_full(self):
+        return len(self.segments) >= PLANNER_BLOCKS
+
+    def idle(self):
+        return not self.segments and self.speed == 0.0
+
+    def queue(self, target, feed):
+        self.segments.append([target, feed])
+
+    def remaining(self):
+        total, pos = 0.0, self.mpos
+        for target, _ in self.segments:
+            total += math.dist(pos, target)
+            pos = target
+        return total
+
+    def stop(self):
+        """Decelerate to a stop along the current direction, as JogCancel and reset do."""
+        if not self.segments or self.speed == 0.0:
+            self.segments = []
+            self.speed = 0.0
+            return
+        target = self.segments[0][0]
+        d = math.dist(self.mpos, target)
+        stop_dist = min(d, self.speed * self.speed / (2 * self.accel))
+        if d > 0:
+            stop = [p + (t - p) * stop_dist / d for p, t in zip(self.mpos, target)]
+        else:
+            stop = list(self.mpos)
+        self.segments = [[stop, self.segments[0][1]]]
+
+    def tick(self, dt):
+        if self.program and self.state == "Run":
+            self._feed_program(dt)
+        if self.segments:
+            feed = self.segments[0][1]
+            if self.state == "Run":
+                feed = feed * self.feed_ovr / 100
+            want = 0.0 if self.holding else min(feed / 60.0, math.sqrt(2 * self.accel * self.remaining()))
+            if self.speed < want:
+                self.speed = min(want, self.speed + self.accel * dt)
+            else:
+                self.speed = max(want, self.speed - self.accel * dt)
+            travel = self.speed * dt
+            while self.segments and travel > 0:
+                target = self.segments[0][0]
+                d = math.dist(self.mpos, target)
+                if d <= travel:
+                    self.mpos = list(target)
+                    self.segments.pop(0)
+                    travel -= d
+                else:
+                    self.mpos = [p + (t - p) * travel / d for p, t in zip(self.mpos, target)]
+                    travel = 0
+            if not self.segments:
+                self.speed = 0.0
+        if self.holding and self.speed == 0.0 and self.state == "Hold:1":
+            self.state = "Hold:0"
+        if self.idle() and (self.state in ("Jog", "Home") or (self.state == "Run" and not self.program)):
+            self.state = "Idle"
+
+    def _feed_program(self, dt):
+        if self.holding:
+            return
+        self.line_credit += dt * self.lines_per_sec
+        name, lines, n = self.program
+        while self.line_credit >= 1 and n < len(lines) and not self.planner_full():
+            self.line_credit -= 1
+            target, feed = list(self.mpos if not self.segments else self.segments[-1][0]), 1000.0
+            words = dict((w[0], float(w[1])) for w in re.findall(r"([A-Z])\s*([-+]?[0-9.]+)", lines[n].upper()))
+            for i, axis in enumerate(AXES):
+                if axis in words:
+                    target[i] = words[axis] + self.wco[i]
+            if "F" in words:
+                feed = words["F"]
+            if "S" in words:
+                self.spindle = int(words["S"])
+            if any(a in words for a in AXES):
+                self.queue(target, feed)
+            n += 1
+        self.program[2] = n
+        if n >= len(lines):
+            self.program = None
+            self.spindle = 0
+
+    def percent(self):
+        name, lines, n = self.program
+        return 100.0 * n / max(1, len(lines))
+
+    def feed_rate(self):
+        return self.speed * 60.0
+
+
+class Session:
+    """One client link: a Telnet socket or the pty."""
+
+    def __init__(self, sim, name, fd, sock=None):
+        self.sim = sim
+        self.name = name
+        self.fd = fd
+        self.sock = sock
+        self.rx = b""
+        self.lines = []  # Received lines waiting for planner space
+        self.outq = []  # (due time, bytes), for --latency
+        self.report_ms = 0
+        self.next_report = 0.0
+        self.reports = 0
+        self.last_report = None
+        self.opened = time.monotonic()
+        self.stats = dict(rx=0, tx=0, lines=0, jogs=0, cancels=0, reports=0)
+
+    def send(self, text):
+        data = text.encode()
+        self.outq.append((time.monotonic() + self.sim.latency, data))
+
+    def sendline(self, text):
+        self.send(text + EOL)
+
+    def flush(self, now):
+        while self.outq and self.outq[0][0] <= now:
+            data = self.outq.pop(0)[1]
+            try:
+                if self.sock:
+                    self.sock.sendall(data)
+                else:
+                    os.write(self.fd, data)
+            except BlockingIOError:
+                continue  # Nobody is draining the pty
+            except OSError:
+                return False
+            self.stats["tx"] += len(data)
+        return True
+
+    def receive(self, data):
+        self.stats["rx"] += len(data)
+        m = self.sim.machine
+        for b in data:
+            if b == ord("?"):
+                self.status_report()
+            elif b == ord("!"):
+                self.sim.feed_hold()
+            elif b == ord("~"):
+                self.sim.cycle_start()
+            elif b == RESET:
+                self.sim.reset()
+                self.lines = []
+                self.rx = b""
+            elif b == JOG_CANCEL:
+                self.stats["cancels"] += 1
+                if m.state == "Jog":
+                    m.stop()
+                self.lines = [l for l in self.lines if not l.startswith("$J=")]
+            elif 0x90 <= b <= 0x9D:
+                self.sim.override(b)
+            elif b >= 0x80 or b in (0x0C, 0x11, 0x13):
+                pass  # Other realtime commands, echo off, XON/XOFF
+            elif b in (0x0A, 0x0D):
+                if self.rx:
+                    self.lines.append(self.rx.decode(errors="replace").strip())
+                    self.rx = b""
+            else:
+                self.rx += bytes([b])
+
+    def process_lines(self):
+        while self.lines:
+            line = self.lines[0]
+            if self.sim.needs_planner(line) and self.sim.machine.planner_full():
+                return  # Hold the ok back until a block frees up
+            self.lines.pop(0)
+            self.stats["lines"] += 1
+            self.sim.execute(self, line)
+
+    def status_report(self):
+        m = self.sim.machine
+        fmt = lambda v: ",".join("%.3f" % x for x in v)
+        report = "<%s|MPos:%s|FS:%d,%d" % (m.state, fmt(m.mpos), round(m.feed_rate()), m.spindle * m.spindle_ovr // 100)
+        if self.reports % 10 == 0:
+            report += "|WCO:" + fmt(m.wco)
+        elif self.reports % 20 == 1:
+            report += "|Ov:%d,%d,%d" % (m.feed_ovr, m.rapid_ovr, m.spindle_ovr)
+        if m.program:
+            report += "|SD:%.2f,/sd/%s" % (m.percent(), m.program[0])
+        self.reports += 1
+        self.stats["reports"] += 1
+        self.sendline(report + ">")
+
+    def auto_report(self, now):
+        if not self.report_ms or now < self.next_report:
+            return
+        self.next_report = now + self.report_ms / 1000.0
+        m = self.sim.machine
+        summary = (m.state, tuple(round(p, 3) for p in m.mpos), m.feed_ovr, m.spindle_ovr, m.program and m.program[2])
+        if summary != self.last_report:  # FluidNC only auto-reports changes
+            self.last_report = summary
+            self.status_report()
+
+
+class Simulator:
+    def __init__(self, args):
+        self.args = args
+        self.machine = Machine(args)
+        self.sd = FileStore(args.sd, DEFAULT_SD)
+        self.localfs = FileStore(args.localfs, DEFAULT_LOCALFS)
+        self.latency = args.latency / 1000.0
+        self.sessions = []
+        self.sel = selectors.DefaultSelector()
+        self.closed_stats = []
+
+    # ---- realtime commands ----
+
+    def feed_hold(self):
+        m = self.machine
+        if m.state == "Jog":
+            m.stop()
+        elif m.state == "Run":
+            m.holding = True
+            m.state = "Hold:1"
+
+    def cycle_start(self):
+        m = self.machine
+        if m.state.startswith("Hold"):
+            m.holding = False
+            m.state = "Run"
+
+    def reset(self):
+        m = self.machine
+        moving = not m.idle() and m.state in ("Run", "Home", "Hold:1")
+        m.segments, m.speed, m.program, m.holding, m.spindle = [], 0.0, None, False, 0
+        if moving:
+            m.state, m.alarm = "Alarm", 3
+        elif m.state != "Alarm":
+            m.state = "Idle"
+        for s in self.sessions:
+            s.sendline("")
+            s.sendline("Grbl 3.9 [FluidNC v3.9.1 (sim) '$' for help]")
+            if moving:
+                s.sendline("ALARM:3")
+
+    def override(self, b):
+        m = self.machine
+        clamp = lambda v, lo, hi: max(lo, min(hi, v))
+        if b == 0x90:
+            m.feed_ovr = 100
+        elif b in (0x91, 0x92, 0x93, 0x94):
+            m.feed_ovr = clamp(m.feed_ovr + {0x91: 10, 0x92: -10, 0x93: 1, 0x94: -1}[b], 10, 200)
+        elif b in (0x95, 0x96, 0x97):
+            m.rapid_ovr = {0x95: 100, 0x96: 50, 0x97: 25}[b]
+        elif b == 0x99:
+            m.spindle_ovr = 100
+        elif b in (0x9A, 0x9B, 0x9C, 0x9D):
+            m.spindle_ovr = clamp(m.spindle_ovr + {0x9A: 10, 0x9B: -10, 0x9C: 1, 0x9D: -1}[b], 10, 200)
+
+    # ---- line commands ----
+
+    def needs_planner(self, line):
+        return line.startswith("$J=")
+
+    def execute(self, s, line):
+        m = self.machine
+        if self.args.error_rate and random.random() < self.args.error_rate:
+            s.sendline("error:%d" % random.choice((1, 2, 3, 20)))
+            return
+        upper = line.upper()
+        if line.startswith("$J="):
+            s.stats["jogs"] += 1
+            s.sendline(self.jog(line[3:]))
+            return
+        if upper in ("", "$"):
+            pass
+        elif upper == "$G":
+            s.sendline("[GC:G0 G54 G17 G21 G90 G94 M%d M9 T0 F0 S%d]" % (3 if m.spindle else 5, m.spindle))
+        elif upper == "$I":
+            s.sendline("[VER:3.9 FluidNC v3.9.1 (sim):]")
+            s.sendline("[OPT:PHS]")
+            s.sendline("[MSG: Machine: FluidNC simulator]")
+        elif upper == "$A":
+            s.sendline("Active alarm: %d" % m.alarm)
+        elif upper == "$X":
+            if m.state == "Alarm":
+                m.state, m.alarm = "Idle", 0
+                s.sendline("[MSG:INFO: Caution: Unlocked]")
+        elif upper.startswith("$H"):
+            if m.state not in ("Idle", "Alarm"):
+                s.sendline("error:8")
+                return
+            target = list(m.mpos)
+            for i, axis in enumerate(AXES):
+                if len(upper) == 2 or axis in upper[2:]:
+                    target[i] = 0.0
+            m.queue(target, 1000.0)
+            m.state, m.alarm = "Home", 0
+        elif upper.startswith("$RI="):
+            s.report_ms = int(line[4:] or 0)
+            s.next_report = 0.0
+        elif re.fullmatch(r"\$/AXES/[XYZ]/HOMING/(CYCLE|ALLOW_SINGLE_AXIS)", upper):
+            value = str(AXES.index(upper[7]) + 1 if upper.endswith("CYCLE") else "true")
+            s.sendline(line + "=" + value)
+        elif upper.startswith("$FILES/LISTGCODE"):
+            self.list_files(s, line.partition("=")[2] or "/sd")
+        elif upper.startswith("$FILE/SHOWSOME="):
+            self.show_some(s, line.partition("=")[2])
+        elif upper.startswith("$FILE/SENDJSON="):
+            self.send_json(s, line.partition("=")[2])
+        elif upper.startswith("$SD/RUN=") or upper.startswith("$LOCALFS/RUN="):
+            self.run(s, line.partition("=")[2], self.sd if upper.startswith("$SD") else self.localfs)
+            return
+        elif line.startswith("$"):
+            pass  # Settings and other $ commands are accepted and ignored
+        elif m.state == "Alarm":
+            s.sendline("error:9")
+            return
+        s.sendline("ok")
+
+    def jog(self, args):
+        m = self.machine
+        if m.state not in ("Idle", "Jog"):
+            return "error:8"
+        words = re.findall(r"([A-Z])\s*([-+]?[0-9.]+)", args.upper())
+        relative, scale, feed = False, 1.0, None
+        base = list(m.segments[-1][0] if m.segments else m.mpos)
+        target = list(base)
+        for letter, value in words:
+            v = float(value)
+            if letter == "G":
+                relative = {90: False, 91: True}.get(int(v), relative)
+                scale = {20: 25.4, 21: 1.0}.get(int(v), scale)
+            elif letter == "F":
+                feed = v
+            elif letter in AXES:
+                i = AXES.index(letter)
+                target[i] = base[i] + v * scale if relative else v * scale + m.wco[i]
+        if feed is None:
+            return "error:22"
+        m.queue(target, feed * scale)
+        m.state = "Jog"
+        return "ok"
+
+    def send_document(self, s, head, array_key, items, tail=""):
+        """Send a JSON reply with one array element per line, as large FluidNC documents arrive."""
+        s.sendline(head[:-1] + ',"%s":[' % array_key)
+        for i, item in enumerate(items):
+            s.sendline(json.dumps(item) + ("," if i < len(items) - 1 else ""))
+        s.sendline("]" + tail + "}")
+
+    def head(self, cmd, argument, status="ok", **extra):
+        doc = dict(cmd=cmd, argument=argument, status=status)
+        doc.update(extra)
+        return json.dumps(doc, separators=(",", ":"))
+
+    def list_files(self, s, path):
+        fs, sub = split_fs(path)
+        entries = (self.sd if fs == "sd" else self.localfs).listing(sub)
+        if entries is None:
+            s.sendline(self.head("$Files/ListGCode", path, "error", error="Not a directory"))
+            return
+        files = [dict(name=name, size=str(size)) for name, size in entries]
+        self.send_document(s, self.head("$Files/ListGCode", path), "files", files, ',"path":%s' % json.dumps(path))
+
+    def show_some(self, s, argument):
+        span, _, path = argument.partition(",")
+        first, _, last = span.partition(":")
+        fs, name = split_fs(path)
+        text = (self.sd if fs == "sd" else self.localfs).read(name)
+        if text is None:
+            s.sendline(self.head("$File/ShowSome", argument, "error", error="File not found"))
+            return
+        first, last = int(first or 0), int(last or 0)
+        lines = text.splitlines()[first:last]
+        self.send_document(s, self.head("$File/ShowSome", argument), "file_lines", lines, ',"firstline":%d' % first)
+
+    def send_json(self, s, path):
+        fs, name = split_fs(path, "localfs")  # FluidNC resolves bare JSON paths on the local filesystem
+        text = (self.sd if fs == "sd" else self.localfs).read(name)
+        try:
+            result = json.loads(text) if text is not None else None
+        except ValueError:
+            result = None
+        if result is None:
+            s.sendline(self.head("$File/SendJSON", path, "error", error="File not found"))
+            return
+        s.sendline(self.head("$File/SendJSON", path)[:-1] + ',"result":')
+        s.sendline(json.dumps(result))
+        s.sendline("}")
+
+    def run(self, s, path, store):
+        m = self.machine
+        if m.state != "Idle":
+            s.sendline("error:8")
+            return
+        name = path.strip("/")
+        if store is self.sd and name.startswith("sd/"):
+            name = name[3:]
+        text = store.read(name)
+        if text is None:
+            s.sendline("error:60")
+            return
+        s.sendline("ok")
+        m.program = [os.path.basename(name), text.splitlines(), 0]
+        m.line_credit = 0.0
+        m.state = "Run"
+
+    # ---- event loop ----
+
+    def add_session(self, session):
+        self.sessions.append(session)
+        self.sel.register(session.fd, selectors.EVENT_READ, session)
+        print("%s: connected" % session.name, flush=True)
+
+    def close_session(self, session, why):
+        self.sel.unregister(session.fd)
+        self.sessions.remove(session)
+        if session.sock:
+            session.sock.close()
+        print("%s: %s after %.1f s" % (session.name, why, time.monotonic() - session.opened), flush=True)
+        self.closed_stats.append(session.stats)
+
+    def print_stats(self):
+        totals = dict(rx=0, tx=0, lines=0, jogs=0, cancels=0, reports=0)
+        for stats in self.closed_stats + [s.stats for s in self.sessions]:
+            for k in totals:
+                totals[k] += stats[k]
+        print(
+            "stats: sessions %d open %d closed, rx %d tx %d bytes, %d lines, %d jogs, %d cancels, %d reports, state %s"
+            % (len(self.sessions), len(self.closed_stats), totals["rx"], totals["tx"], totals["lines"], totals["jogs"], totals["cancels"], totals["reports"], self.machine.state),
+            flush=True,
+        )
+
+    def serve(self):
+        args = self.args
+        listener = None
+        if args.port:
+            listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+            listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+            listener.bind((args.bind, args.port))
+            listener.listen(4)
+            listener.setblocking(False)
+            self.sel.register(listener, selectors.EVENT_READ, None)
+            print("Telnet on %s:%d" % (args.bind, args.port), flush=True)
+        if not args.no_pty:
+            master, slave = pty.openpty()
+            tty.setraw(slave)
+            os.set_blocking(master, False)
+            name = os.ttyname(slave)
+            if args.pty_link:
+                if os.path.islink(args.pty_link):
+                    os.unlink(args.pty_link)
+                os.symlink(name, args.pty_link)
+                name += " (" + args.pty_link + ")"
+            print("Serial on %s" % name, flush=True)
+            self.add_session(Session(self, "pty", master))
+            self.pty_slave = slave  # Held open so the master survives client disconnects
+
+        last = time.monotonic()
+        next_stats = last + args.stats if args.stats else None
+        next_drop = last + args.drop_every if args.drop_every else None
+        while True:
+            for key, _ in self.sel.select(timeout=0.002):
+                if key.data is None:
+                    sock, addr = listener.accept()
+                    sock.setblocking(False)
+                    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                    self.add_session(Session(self, "telnet %s:%d" % addr, sock.fileno(), sock))
+                    continue
+                session = key.data
+                try:
+                    data = session.sock.recv(4096) if session.sock else os.read(session.fd, 4096)
+                except BlockingIOError:
+                    continue
+                except OSError:
+                    data = b"" if session.sock else None
+                if data:
+                    session.receive(data)
+                elif data == b"" and session.sock:
+                    self.close_session(session, "closed by peer")
+
+            now = time.monotonic()
+            self.machine.tick(now - last)
+            last = now
+            for session in list(self.sessions):
+                session.process_lines()
+                session.auto_report(now)
+                if not session.flush(now) and session.sock:
+                    self.close_session(session, "send failed")
+
+            if next_drop and now >= next_drop:
+                next_drop = now + args.drop_every
+                for session in [s for s in self.sessions if s.sock]:
+                    self.close_session(session, "dropped")
+            if next_stats and now >= next_stats:
+                next_stats = now + args.stats
+                self.print_stats()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="FluidNC protocol simulator for pendant testing")
+    parser.add_argument("--port", type=int, default=23, help="Telnet port, 0 to disable (default 23)")
+    parser.add_argument("--bind", default="0.0.0.0", help="Telnet bind address")
+    parser.add_argument("--no-pty", action="store_true", help="Don't serve a pseudo-terminal")
+    parser.add_argument("--pty-link", help="Symlink to create for the pty, e.g. /tmp/fluidnc")
+    parser.add_argument("--sd", help="Directory served as /sd (default: built-in files)")
+    parser.add_argument("--localfs", help="Directory served as /localfs (default: built-in macros)")
+    parser.add_argument("--alarm", action="store_true", help="Start in Alarm, as a machine that must be homed")
+    parser.add_argument("--accel", type=float, default=500.0, help="Acceleration in mm/s^2 (default 500)")
+    parser.add_argument("--run-lps", type=float, default=20.0, help="Program lines fed per second (default 20)")
+    parser.add_argument("--latency", type=float, default=0.0, help="Delay every response by this many ms")
+    parser.add_argument("--error-rate", type=float, default=0.0, help="Fraction of lines answered with error:N")
+    parser.add_argument("--drop-every", type=float, default=0.0, help="Close Telnet sessions every N seconds")
+    parser.add_argument("--stats", type=float, default=0.0, help="Print link statistics every N seconds")
+    args = parser.parse_args()
+
+    sim = Simulator(args)
+    signal.signal(signal.SIGTERM, lambda *_: sys.exit(0))
+    try:
+        sim.serve()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sim.print_stats()
+        if args.pty_link and os.path.islink(args.pty_link):
+            os.unlink(args.pty_link)
+
+
+if __name__ == "__main__":
+    main()